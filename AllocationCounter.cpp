@@ -0,0 +1,68 @@
+#include "AllocationCounter.h"
+
+#ifdef MODELVIEWER_COUNT_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<std::size_t> allocations(0);
+
+#if defined(__GLIBC__)
+//glibc exports its own allocator under __libc_* names, so malloc can be wrapped without dlsym
+extern "C" {
+	void* __libc_malloc(std::size_t size);
+	void* __libc_calloc(std::size_t count, std::size_t size);
+	void* __libc_realloc(void* ptr, std::size_t size);
+
+	void* malloc(std::size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_malloc(size);
+	}
+	void* calloc(std::size_t count, std::size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_calloc(count, size);
+	}
+	void* realloc(void* ptr, std::size_t size) {
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return __libc_realloc(ptr, size);
+	}
+}
+#else
+void* operator new(std::size_t size) {
+	allocations.fetch_add(1, std::memory_order_relaxed);
+	if (void* ptr = std::malloc(size ? size : 1)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+	return operator new(size);
+}
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete[](void* ptr) noexcept {
+	std::free(ptr);
+}
+void operator delete(void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+void operator delete[](void* ptr, std::size_t) noexcept {
+	std::free(ptr);
+}
+#endif
+
+bool allocationCountingEnabled() {
+	return true;
+}
+std::size_t allocationCount() {
+	return allocations.load(std::memory_order_relaxed);
+}
+#else
+bool allocationCountingEnabled() {
+	return false;
+}
+std::size_t allocationCount() {
+	return 0;
+}
+#endif
@@ -0,0 +1,19 @@
+#pragma once
+#include <cstddef>
+
+//Counting of heap allocations made by the process, used to check that steady-state redraws don't allocate.
+//Counting is compiled in only with MODELVIEWER_COUNT_ALLOCATIONS defined, otherwise allocationCount() returns 0.
+//On glibc malloc family is wrapped (Qt containers allocate thru malloc), elsewhere only operator new is counted.
+
+bool allocationCountingEnabled();
+std::size_t allocationCount();
+
+//Counts allocations made between construction and count() call
+class ScopedAllocationCounter {
+private:
+	std::size_t start;
+public:
+	ScopedAllocationCounter() : start(allocationCount()) {}
+	std::size_t count() const { return allocationCount() - start; }
+	void reset() { start = allocationCount(); }
+};
@@ -0,0 +1,299 @@
+//Rendering benchmark, meshes and 2D scene are generated in memory and every stage of pipeline is timed separately over fixed camera poses
+//usage: Benchmark [--triangles 1000,10000,...] [--objects 200] [--poses 8] [--repeat 5] [--size 700x700] [-o result.json]
+//built with MODELVIEWER_COUNT_ALLOCATIONS it also counts heap allocations of steady-state redraw of every 2D and 3D stage and fails when one allocates
+#include "Renderer.h"
+#include "AllocationCounter.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <random>
+
+//Samples of one stage in milliseconds
+class StageTimes {
+public:
+	QVector<double> samples;
+
+	void add(qint64 nanoseconds) { samples.append(nanoseconds / 1e6); }
+	//nearest-rank percentile of sorted samples
+	static double percentile(const QVector<double>& sorted, double p) {
+		if (sorted.isEmpty()) {
+			return 0;
+		}
+		int rank = static_cast<int>(ceil(p / 100 * sorted.length()));
+		return sorted[std::min(std::max(rank, 1), static_cast<int>(sorted.length())) - 1];
+	}
+	QJsonObject toJson() const {
+		QVector<double> sorted = samples;
+		std::sort(sorted.begin(), sorted.end());
+		QJsonObject json;
+		json["samples"] = sorted.length();
+		json["min_ms"] = sorted.isEmpty() ? 0 : sorted.first();
+		json["median_ms"] = percentile(sorted, 50);
+		json["p90_ms"] = percentile(sorted, 90);
+		json["p99_ms"] = percentile(sorted, 99);
+		json["max_ms"] = sorted.isEmpty() ? 0 : sorted.last();
+		return json;
+	}
+};
+
+//Camera poses are fixed, so results of different versions are comparable
+static QVector<QPair<double, double>> cameraPoses(int count) {
+	QVector<QPair<double, double>> poses;
+	for (int i = 0; i < count; i++) {
+		double azimut = 2 * M_PI * i / count;
+		double zenit = M_PI / 6 + (M_PI / 3) * (i % 3) / 2;
+		poses.append({ azimut, zenit });
+	}
+	return poses;
+}
+
+//Heap allocations of second of two same redraws, first one grows scratch buffers of renderer to their steady size.
+//Stage which allocates is added to failed stages
+template <typename Draw>
+static QJsonValue steadyStateAllocations(Renderer& renderer, const QString& stage, QStringList& allocatingStages, Draw draw) {
+	renderer.clear();
+	draw();
+	ScopedAllocationCounter counter;
+	renderer.clear();
+	draw();
+	qint64 allocations = static_cast<qint64>(counter.count());
+	if (allocations > 0) {
+		allocatingStages.append(stage);
+	}
+	return allocations;
+}
+
+//Generates mesh text, parses it and runs every stage on it, generated VTK is kept in memory
+static QJsonObject benchmarkMesh(Renderer& renderer, const QString& name, const QString& vtk, const QVector<QPair<double, double>>& poses, int repeat, QStringList& allocatingStages) {
+	QElapsedTimer timer;
+	StageTimes load, transform, wireframe, surfaceFlat, surfaceGouraud, save;
+	//stages of lit Gouraud surface as measured by renderer's profiler
+	StageTimes gouraudStages[static_cast<int>(ProfileStage::Count)];
+	LightSettings light(Vertex(500, 500, 100), 0.5, 0.5, 0.5, 1, QColor(255, 255, 255), QColor(0, 0, 255));
+	Object_H_edge object;
+	for (int i = 0; i < repeat; i++) {
+		object.release();
+		QString text = vtk;
+		QTextStream input(&text);
+		timer.start();
+		object = readPolygonsVTK(input);
+		load.add(timer.nsecsElapsed());
+	}
+	if (object.vertices.isEmpty()) {
+		qDebug() << name << " : mesh failed to load";
+		return QJsonObject();
+	}
+	QVector<Vertex> savedVertices;
+	renderer.invalidateProjection();
+	for (const QPair<double, double>& pose : poses) {
+		renderer.getProjectionPlane().setProjectionPlane(pose.first, pose.second);
+		for (int i = 0; i < repeat; i++) {
+			timer.start();
+			renderer.perspectiveCoordSystemTransformation(object, 0, savedVertices);
+			transform.add(timer.nsecsElapsed());
+			for (int j = 0; j < object.vertices.length(); j++) {
+				*object.vertices[j] = savedVertices[j];
+			}
+
+			renderer.clear();
+			//projection cache would hide transform of wireframe after first repeat
+			renderer.invalidateProjection();
+			timer.start();
+			renderer.drawObject(object, 0, 0, 0, nullptr);
+			wireframe.add(timer.nsecsElapsed());
+
+			renderer.clear();
+			timer.start();
+			renderer.drawObject(object, 0, 1, 0, nullptr);
+			surfaceFlat.add(timer.nsecsElapsed());
+
+			renderer.clear();
+			timer.start();
+			renderer.drawObject(object, 0, 1, 1, &light);
+			surfaceGouraud.add(timer.nsecsElapsed());
+			ProfileFrame frame = renderer.getProfiler().lastFrame();
+			for (int stage = 0; stage < static_cast<int>(ProfileStage::Count); stage++) {
+				gouraudStages[stage].add(frame.stageTime[stage]);
+			}
+		}
+	}
+	//redraw from first pose without invalidated projection, as viewer repeats it
+	renderer.getProjectionPlane().setProjectionPlane(poses[0].first, poses[0].second);
+	QJsonObject allocations;
+	allocations["wireframe"] = steadyStateAllocations(renderer, name + "/wireframe", allocatingStages, [&]() { renderer.drawObject(object, 0, 0, 0, nullptr); });
+	allocations["surface_flat"] = steadyStateAllocations(renderer, name + "/surface_flat", allocatingStages, [&]() { renderer.drawObject(object, 0, 1, 0, nullptr); });
+	allocations["surface_gouraud_lit"] = steadyStateAllocations(renderer, name + "/surface_gouraud_lit", allocatingStages, [&]() { renderer.drawObject(object, 0, 1, 1, &light); });
+	for (int i = 0; i < repeat; i++) {
+		QString text;
+		QTextStream output(&text);
+		timer.start();
+		writePolygonsVTK(output, object);
+		output.flush();
+		save.add(timer.nsecsElapsed());
+	}
+	QJsonObject stages;
+	stages["vtk_load"] = load.toJson();
+	stages["transform"] = transform.toJson();
+	stages["wireframe"] = wireframe.toJson();
+	stages["surface_flat"] = surfaceFlat.toJson();
+	stages["surface_gouraud_lit"] = surfaceGouraud.toJson();
+	stages["vtk_save"] = save.toJson();
+	QJsonObject gouraudBreakdown;
+	for (int stage = 0; stage < static_cast<int>(ProfileStage::Count); stage++) {
+		gouraudBreakdown[FrameProfiler::stageName(static_cast<ProfileStage>(stage))] = gouraudStages[stage].toJson();
+	}
+	stages["surface_gouraud_lit_stages"] = gouraudBreakdown;
+	QJsonObject json;
+	json["mesh"] = name;
+	json["vertices"] = object.vertices.length();
+	json["triangles"] = object.triangle_indices.length() / 3;
+	json["stages"] = stages;
+	json["steady_state_allocations"] = allocations;
+	object.release();
+	return json;
+}
+
+//2D scene with count objects of every type spread over image, random generator has fixed seed so scenes of different versions are same
+static QMap<QString, Object2D> generateScene2D(QSize size, int count) {
+	QMap<QString, Object2D> objects;
+	std::mt19937 random(2024);
+	auto point = [&random, size]() { return QPoint(static_cast<int>(random() % size.width()), static_cast<int>(random() % size.height())); };
+	auto color = [&random]() { return QColor(static_cast<int>(random() % 256), static_cast<int>(random() % 256), static_cast<int>(random() % 256)); };
+	int layer = 0;
+	for (int i = 0; i < count; i++) {
+		objects.insert(QString("line (%1)").arg(i), Object2D("line", QString("line (%1)").arg(i), { point(), point() }, color(), layer++));
+		QPoint center = point();
+		objects.insert(QString("circle (%1)").arg(i), Object2D("circle", QString("circle (%1)").arg(i), { center, center + QPoint(static_cast<int>(random() % 60), 0) }, color(), layer++));
+		center = point();
+		objects.insert(QString("ellipse (%1)").arg(i), Object2D("ellipse", QString("ellipse (%1)").arg(i),
+			{ center, center + QPoint(static_cast<int>(random() % 80), static_cast<int>(random() % 40)) }, color(), color(), i % 2, layer++));
+		QVector<QPoint> polygon;
+		center = point();
+		for (int j = 0; j < 5; j++) {
+			double angle = 2 * M_PI * j / 5;
+			double radius = 10 + random() % 50;
+			polygon.append(center + QPoint(static_cast<int>(radius * cos(angle)), static_cast<int>(radius * sin(angle))));
+		}
+		objects.insert(QString("polygon (%1)").arg(i), Object2D("polygon", QString("polygon (%1)").arg(i), polygon, Qt::black, color(), 1 + i % 3, layer++));
+		QVector<QPair<QPoint, QPoint>> curvePoints;
+		for (int j = 0; j < 4; j++) {
+			QPoint controlPoint = point();
+			curvePoints.append({ controlPoint, controlPoint - QPoint(0, 100) });
+		}
+		objects.insert(QString("curve (%1)").arg(i), Object2D("curve", QString("curve (%1)").arg(i), curvePoints, color(), i % 3, layer++));
+	}
+	return objects;
+}
+
+//Times redraw of whole 2D scene, aliased and anti-aliased
+static QJsonObject benchmarkScene2D(Renderer& renderer, const QMap<QString, Object2D>& objects, int repeat, QStringList& allocatingStages) {
+	QElapsedTimer timer;
+	QJsonObject stages;
+	QJsonObject allocations;
+	for (int antialiasing = 0; antialiasing < 2; antialiasing++) {
+		const QString stage = antialiasing ? "draw_antialiased" : "draw";
+		renderer.setAntialiasing(antialiasing);
+		StageTimes times;
+		for (int i = 0; i < repeat; i++) {
+			renderer.clear();
+			timer.start();
+			renderer.drawObjects2D(objects);
+			times.add(timer.nsecsElapsed());
+		}
+		stages[stage] = times.toJson();
+		allocations[stage] = steadyStateAllocations(renderer, "scene_2d/" + stage, allocatingStages, [&]() { renderer.drawObjects2D(objects); });
+	}
+	renderer.setAntialiasing(false);
+	QJsonObject json;
+	json["objects"] = objects.size();
+	json["stages"] = stages;
+	json["steady_state_allocations"] = allocations;
+	return json;
+}
+
+int main(int argc, char* argv[])
+{
+	QLocale::setDefault(QLocale::c());
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("Benchmark");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Times rendering stages on generated meshes and writes results as JSON.");
+	parser.addHelpOption();
+	QCommandLineOption trianglesOption("triangles", "Comma separated triangle counts of generated spheres.", "counts", "1000,10000,100000,1000000,10000000");
+	QCommandLineOption objectsOption("objects", "Number of objects of every type in generated 2D scene.", "count", "200");
+	QCommandLineOption posesOption("poses", "Number of camera poses.", "count", "8");
+	QCommandLineOption repeatOption("repeat", "Repetitions of every stage per pose.", "count", "5");
+	QCommandLineOption sizeOption("size", "Image size WIDTHxHEIGHT.", "size", "700x700");
+	QCommandLineOption outputOption({ "o", "output" }, "Output JSON file, standard output when not set.", "file");
+	parser.addOptions({ trianglesOption, objectsOption, posesOption, repeatOption, sizeOption, outputOption });
+	parser.process(app);
+
+	QStringList size = parser.value(sizeOption).split('x');
+	if (size.length() != 2 || size[0].toInt() <= 0 || size[1].toInt() <= 0) {
+		qDebug() << "invalid size : " << parser.value(sizeOption);
+		return 1;
+	}
+	QSize imageSize(size[0].toInt(), size[1].toInt());
+	int repeat = std::max(parser.value(repeatOption).toInt(), 1);
+	QVector<QPair<double, double>> poses = cameraPoses(std::max(parser.value(posesOption).toInt(), 1));
+	Renderer renderer(imageSize);
+	//profiler gives stage breakdown, covered pixels aren't counted so frame times don't include scan of Z-buffer
+	renderer.getProfiler().setEnabled(true);
+	renderer.getProfiler().setPixelCounting(false);
+	//meshes fill about 80 % of smaller side of image
+	double radius = 0.4 * std::min(imageSize.width(), imageSize.height());
+
+	QStringList allocatingStages;
+	QJsonObject scene2D = benchmarkScene2D(renderer, generateScene2D(imageSize, std::max(parser.value(objectsOption).toInt(), 1)), repeat, allocatingStages);
+
+	QJsonArray meshes;
+	{
+		QString vtk;
+		QTextStream out(&vtk);
+		writeCubeVTK(out, radius);
+		out.flush();
+		meshes.append(benchmarkMesh(renderer, "cube", vtk, poses, repeat, allocatingStages));
+	}
+	for (const QString& count : parser.value(trianglesOption).split(',')) {
+		//UV sphere with n meridians and n parallels has 2n^2 - 2 triangles
+		int n = std::max(static_cast<int>(round(sqrt(count.toDouble() / 2))), 3);
+		QString vtk;
+		QTextStream out(&vtk);
+		writeUvSphereVTK(out, radius, n, n, 0);
+		out.flush();
+		meshes.append(benchmarkMesh(renderer, "uv_sphere_" + count.trimmed(), vtk, poses, repeat, allocatingStages));
+	}
+
+	QJsonObject result;
+	result["image_width"] = imageSize.width();
+	result["image_height"] = imageSize.height();
+	result["poses"] = poses.length();
+	result["repeat"] = repeat;
+	result["allocation_counting"] = allocationCountingEnabled();
+	result["scene_2d"] = scene2D;
+	result["meshes"] = meshes;
+	QByteArray json = QJsonDocument(result).toJson();
+	if (parser.isSet(outputOption)) {
+		QFile file(parser.value(outputOption));
+		if (!file.open(QIODevice::WriteOnly)) {
+			qDebug() << parser.value(outputOption) << " : file failed to open";
+			return 1;
+		}
+		file.write(json);
+		file.close();
+	}
+	else {
+		QTextStream(stdout) << json;
+	}
+	if (!allocatingStages.isEmpty()) {
+		qDebug() << "steady-state redraw allocates : " << allocatingStages.join(", ");
+		return 1;
+	}
+	return 0;
+}
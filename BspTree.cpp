@@ -0,0 +1,335 @@
+#include "BspTree.h"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+
+//Larger sets are split by axis plane through median of centroids, which keeps tree shallow,
+//smaller ones and sets that plane would cut too much are split by planes of their own triangles
+static const int bspMedianSplitMin = 256;
+//Small set whose triangles all lie behind planes of each other (or all in front with inverted orientation) is kept as convex leaf,
+//no triangle of it hides one facing outwards to viewer, so its order is triangles facing away first
+static const int bspConvexLeafMax = 4096;
+//Triangles whose planes are tried as splitter of set, plane cutting fewest triangles wins
+static const int bspSplitterCandidates = 8;
+
+bool BspTree::isBuiltFor(const Object_H_edge& object) const {
+	return faceData == object.faces.constData() && faceCount == object.faces.length() && objectVertices == object.vertices.length();
+}
+
+void BspTree::build(const Object_H_edge& object, const QVector<Vertex>& positions) {
+	faceData = object.faces.constData();
+	faceCount = object.faces.length();
+	objectVertices = object.vertices.length();
+	vertices = positions;
+	triangles.resize(0);
+	nodeTriangles.resize(0);
+	nodes.resize(0);
+	QHash<const Vertex*, int> vertexIndex;
+	vertexIndex.reserve(objectVertices);
+	for (int i = 0; i < objectVertices; i++) {
+		vertexIndex.insert(object.vertices[i], i);
+	}
+	//same faces as surface with Z-buffer, only triangles are filled
+	for (Face* face : object.faces) {
+		BspTriangle triangle;
+		triangle.face = face;
+		int vertexCount = 0;
+		const H_edge* edge = face->edge;
+		do {
+			if (vertexCount < 3) {
+				triangle.vertices[vertexCount] = vertexIndex.value(edge->vert_origin);
+			}
+			vertexCount++;
+			edge = edge->edge_next;
+		} while (edge != face->edge);
+		if (vertexCount == 3) {
+			triangles.append(triangle);
+		}
+	}
+	if (triangles.isEmpty()) {
+		return;
+	}
+	//points closer to plane than epsilon lie in it, epsilon follows size of object
+	Vertex minimum(DBL_MAX, DBL_MAX, DBL_MAX);
+	Vertex maximum(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	for (const Vertex& vertex : vertices) {
+		minimum = Vertex(std::min(minimum.x, vertex.x), std::min(minimum.y, vertex.y), std::min(minimum.z, vertex.z));
+		maximum = Vertex(std::max(maximum.x, vertex.x), std::max(maximum.y, vertex.y), std::max(maximum.z, vertex.z));
+	}
+	const double epsilon = 1e-7 * std::max({ maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z, 1e-12 });
+	auto side = [epsilon](double distance) { return distance > epsilon ? 1 : distance < -epsilon ? -1 : 0; };
+	auto triangleSides = [&](int triangle, const Vertex& normal, double distance, std::array<int, 3>& sides) {
+		for (int k = 0; k < 3; k++) {
+			sides[k] = side(vertices[triangles[triangle].vertices[k]] * normal - distance);
+		}
+	};
+	//counts triangles of set lying fully in front, fully behind and cut by plane
+	auto countSides = [&](const QVector<int>& set, const Vertex& normal, double distance, int& front, int& back, int& cut) {
+		front = back = cut = 0;
+		std::array<int, 3> sides;
+		for (int triangle : set) {
+			triangleSides(triangle, normal, distance, sides);
+			bool anyFront = sides[0] > 0 || sides[1] > 0 || sides[2] > 0;
+			bool anyBack = sides[0] < 0 || sides[1] < 0 || sides[2] < 0;
+			front += anyFront && !anyBack;
+			back += anyBack && !anyFront;
+			cut += anyFront && anyBack;
+		}
+	};
+	auto trianglePlane = [this](int triangle, Vertex& normal, double& distance) {
+		const Vertex& A = vertices[triangles[triangle].vertices[0]];
+		const Vertex& B = vertices[triangles[triangle].vertices[1]];
+		const Vertex& C = vertices[triangles[triangle].vertices[2]];
+		//in doubles, vertices of triangle have to lie in its own plane within epsilon
+		Vertex cross((B.y - A.y) * (C.z - A.z) - (B.z - A.z) * (C.y - A.y), (B.z - A.z) * (C.x - A.x) - (B.x - A.x) * (C.z - A.z),
+			(B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x));
+		double length = sqrt(cross * cross);
+		if (length <= 0) {
+			return false;
+		}
+		normal = Vertex(cross.x / length, cross.y / length, cross.z / length);
+		distance = normal * A;
+		return true;
+	};
+
+	struct BuildSet {
+		int node;
+		QVector<int> triangles;
+	};
+	QVector<BuildSet> work;
+	{
+		BuildSet root{ 0, QVector<int>(triangles.length()) };
+		for (int i = 0; i < triangles.length(); i++) {
+			root.triangles[i] = i;
+		}
+		nodes.append(BspNode());
+		work.append(std::move(root));
+	}
+	//vertex made on edge of split, shared edge of neighbouring triangles gets one vertex
+	QHash<QPair<int, int>, int> splitVertices;
+	QVector<int> polygonFront, polygonBack;
+	QVector<int> setVertices;
+	QVector<int> vertexStamp(vertices.length(), -1);
+	while (!work.isEmpty()) {
+		BuildSet set = work.takeLast();
+		const int count = set.triangles.length();
+		Vertex normal;
+		double distance = 0;
+		bool planeFound = false;
+		int splitter = -1;
+		if (count <= bspConvexLeafMax) {
+			//planes are tested against vertices of set, few planes spread over set go first so most sets fail early
+			setVertices.resize(0);
+			for (int triangle : set.triangles) {
+				for (int vertex : triangles[triangle].vertices) {
+					if (vertexStamp[vertex] != set.node) {
+						vertexStamp[vertex] = set.node;
+						setVertices.append(vertex);
+					}
+				}
+			}
+			bool allBehind = true, allFront = true;
+			const int samples = std::min(count, 16);
+			for (int n = 0; n < samples + count && (allBehind || allFront); n++) {
+				Vertex planeNormal;
+				double planeDistance;
+				if (!trianglePlane(set.triangles[n < samples ? n * count / samples : n - samples], planeNormal, planeDistance)) {
+					continue;
+				}
+				for (int vertex : setVertices) {
+					int vertexSide = side(vertices[vertex] * planeNormal - planeDistance);
+					allBehind = allBehind && vertexSide <= 0;
+					allFront = allFront && vertexSide >= 0;
+				}
+			}
+			if (allBehind || allFront) {
+				BspNode& node = nodes[set.node];
+				node.convex = allBehind ? 1 : -1;
+				node.first = nodeTriangles.length();
+				node.count = count;
+				nodeTriangles.append(set.triangles);
+				continue;
+			}
+		}
+		if (count >= bspMedianSplitMin) {
+			Vertex low(DBL_MAX, DBL_MAX, DBL_MAX);
+			Vertex high(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+			QVector<double> centroids(count);
+			for (int triangle : set.triangles) {
+				for (int vertex : triangles[triangle].vertices) {
+					const Vertex& position = vertices[vertex];
+					low = Vertex(std::min(low.x, position.x), std::min(low.y, position.y), std::min(low.z, position.z));
+					high = Vertex(std::max(high.x, position.x), std::max(high.y, position.y), std::max(high.z, position.z));
+				}
+			}
+			double sizeX = high.x - low.x, sizeY = high.y - low.y, sizeZ = high.z - low.z;
+			int axis = (sizeX >= sizeY && sizeX >= sizeZ) ? 0 : (sizeY >= sizeZ ? 1 : 2);
+			Vertex axisNormal(axis == 0, axis == 1, axis == 2);
+			for (int i = 0; i < count; i++) {
+				const BspTriangle& triangle = triangles[set.triangles[i]];
+				centroids[i] = (vertices[triangle.vertices[0]] * axisNormal + vertices[triangle.vertices[1]] * axisNormal + vertices[triangle.vertices[2]] * axisNormal) / 3;
+			}
+			std::nth_element(centroids.begin(), centroids.begin() + count / 2, centroids.end());
+			//plane is taken only when it cuts few triangles, both sides are then smaller than set
+			int front, back, cut;
+			countSides(set.triangles, axisNormal, centroids[count / 2], front, back, cut);
+			if (8 * cut < std::min(front, back)) {
+				normal = axisNormal;
+				distance = centroids[count / 2];
+				planeFound = true;
+			}
+		}
+		if (!planeFound) {
+			//triangle of plane stays in node, so every side is smaller than set even when all others lie on one side
+			int bestScore = INT_MAX;
+			const int candidates = std::min(count, bspSplitterCandidates);
+			for (int c = 0; c < candidates; c++) {
+				int candidate = set.triangles[c * count / candidates];
+				Vertex candidateNormal;
+				double candidateDistance;
+				if (!trianglePlane(candidate, candidateNormal, candidateDistance)) {
+					continue;
+				}
+				int front, back, cut;
+				countSides(set.triangles, candidateNormal, candidateDistance, front, back, cut);
+				int score = 8 * cut + abs(front - back);
+				if (score < bestScore) {
+					bestScore = score;
+					normal = candidateNormal;
+					distance = candidateDistance;
+					planeFound = true;
+					splitter = candidate;
+				}
+			}
+			for (int i = 0; i < count && !planeFound; i++) {
+				planeFound = trianglePlane(set.triangles[i], normal, distance);
+				splitter = set.triangles[i];
+			}
+		}
+		//set of degenerate triangles only is kept in node in any order, its normal is zero
+		QVector<int> frontSet, backSet;
+		nodes[set.node].normal = normal;
+		nodes[set.node].distance = distance;
+		nodes[set.node].first = nodeTriangles.length();
+		splitVertices.clear();
+		std::array<int, 3> sides;
+		for (int triangle : set.triangles) {
+			if (!planeFound) {
+				nodeTriangles.append(triangle);
+				continue;
+			}
+			triangleSides(triangle, normal, distance, sides);
+			bool anyFront = sides[0] > 0 || sides[1] > 0 || sides[2] > 0;
+			bool anyBack = sides[0] < 0 || sides[1] < 0 || sides[2] < 0;
+			if (triangle == splitter || (!anyFront && !anyBack)) {
+				nodeTriangles.append(triangle);
+			}
+			else if (!anyBack) {
+				frontSet.append(triangle);
+			}
+			else if (!anyFront) {
+				backSet.append(triangle);
+			}
+			else {
+				//cut triangle is clipped into polygon on each side, vertices in plane belong to both
+				const BspTriangle source = triangles[triangle];
+				polygonFront.resize(0);
+				polygonBack.resize(0);
+				for (int k = 0; k < 3; k++) {
+					int a = source.vertices[k], b = source.vertices[(k + 1) % 3];
+					int sideA = sides[k], sideB = sides[(k + 1) % 3];
+					if (sideA >= 0) {
+						polygonFront.append(a);
+					}
+					if (sideA <= 0) {
+						polygonBack.append(a);
+					}
+					if (sideA * sideB < 0) {
+						QPair<int, int> key(std::min(a, b), std::max(a, b));
+						int split = splitVertices.value(key, -1);
+						if (split < 0) {
+							//position is computed from lower index, so both triangles of edge get same vertex
+							const Vertex P = vertices[key.first];
+							const Vertex Q = vertices[key.second];
+							double distanceP = P * normal - distance;
+							double t = distanceP / (distanceP - (Q * normal - distance));
+							split = vertices.length();
+							vertexStamp.append(-1);
+							vertices.append(Vertex(P.x + t * (Q.x - P.x), P.y + t * (Q.y - P.y), P.z + t * (Q.z - P.z)));
+							splitVertices.insert(key, split);
+						}
+						polygonFront.append(split);
+						polygonBack.append(split);
+					}
+				}
+				for (int part = 0; part < 2; part++) {
+					const QVector<int>& polygon = part == 0 ? polygonFront : polygonBack;
+					for (int k = 2; k < polygon.length(); k++) {
+						(part == 0 ? frontSet : backSet).append(triangles.length());
+						triangles.append(BspTriangle{ { polygon[0], polygon[k - 1], polygon[k] }, source.face });
+					}
+				}
+			}
+		}
+		nodes[set.node].count = nodeTriangles.length() - nodes[set.node].first;
+		if (!frontSet.isEmpty()) {
+			nodes[set.node].front = nodes.length();
+			nodes.append(BspNode());
+			work.append({ nodes[set.node].front, std::move(frontSet) });
+		}
+		if (!backSet.isEmpty()) {
+			nodes[set.node].back = nodes.length();
+			nodes.append(BspNode());
+			work.append({ nodes[set.node].back, std::move(backSet) });
+		}
+	}
+}
+
+void BspTree::backToFront(const Vertex& eye, bool orthographic, QVector<int>& order, QVector<int>& stack) const {
+	order.resize(0);
+	if (nodes.isEmpty()) {
+		return;
+	}
+	//tree is walked without recursion, entry ~node draws triangles of node itself,
+	//side of plane away from eye is pushed last so it's taken first
+	stack.resize(0);
+	stack.append(0);
+	while (!stack.isEmpty()) {
+		int entry = stack.takeLast();
+		if (entry < 0) {
+			const BspNode& node = nodes[~entry];
+			for (int i = node.first; i < node.first + node.count; i++) {
+				order.append(nodeTriangles[i]);
+			}
+			continue;
+		}
+		const BspNode& node = nodes[entry];
+		if (node.convex != 0) {
+			for (int facing = 0; facing < 2; facing++) {
+				for (int i = node.first; i < node.first + node.count; i++) {
+					const BspTriangle& triangle = triangles[nodeTriangles[i]];
+					const Vertex& A = vertices[triangle.vertices[0]];
+					const Vertex& B = vertices[triangle.vertices[1]];
+					const Vertex& C = vertices[triangle.vertices[2]];
+					Vertex normal((B.y - A.y) * (C.z - A.z) - (B.z - A.z) * (C.y - A.y), (B.z - A.z) * (C.x - A.x) - (B.x - A.x) * (C.z - A.z),
+						(B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x));
+					double eyeSide = node.convex * (orthographic ? normal * eye : normal * eye - normal * A);
+					if ((eyeSide > 0) == (facing == 1)) {
+						order.append(nodeTriangles[i]);
+					}
+				}
+			}
+			continue;
+		}
+		double eyeSide = orthographic ? node.normal * eye : node.normal * eye - node.distance;
+		int nearChild = eyeSide >= 0 ? node.front : node.back;
+		int farChild = eyeSide >= 0 ? node.back : node.front;
+		if (nearChild >= 0) {
+			stack.append(nearChild);
+		}
+		stack.append(~entry);
+		if (farChild >= 0) {
+			stack.append(farChild);
+		}
+	}
+}
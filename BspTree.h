@@ -0,0 +1,48 @@
+#pragma once
+
+#include <QVector>
+#include <array>
+#include "HalfEdge.h"
+
+//Triangle of BSP tree, vertices index into vertices of tree, pieces of split faces keep their face for color
+struct BspTriangle {
+	std::array<int, 3> vertices;
+	Face* face = nullptr;
+};
+
+//Node of BSP tree, plane is normal * point = distance, triangles lying in plane are run of tree's triangle list,
+//child is -1 when its side is empty. Convex leaf has no plane, its run holds triangles of convex part of surface,
+//convex is 1 when they lie behind planes of each other and -1 when in front (inverted orientation)
+struct BspNode {
+	Vertex normal;
+	double distance = 0;
+	int front = -1, back = -1;
+	int first = 0, count = 0;
+	int convex = 0;
+};
+
+//BSP tree of static object built in coordinates of object, its walk gives triangles back to front from any viewpoint.
+//First vertices of tree are vertices of object in their order, vertices made by splits follow them
+class BspTree {
+private:
+	const Face* const* faceData = nullptr;
+	int faceCount = 0;
+	int objectVertices = 0;
+	QVector<Vertex> vertices;
+	QVector<BspTriangle> triangles;
+	QVector<int> nodeTriangles;
+	QVector<BspNode> nodes;
+
+public:
+	//positions of object's vertices are given separately, drawn object has them transformed in place
+	void build(const Object_H_edge& object, const QVector<Vertex>& positions);
+	bool isBuiltFor(const Object_H_edge& object) const;
+	//Triangles from back to front seen from eye, orthographic view gives direction towards viewer instead of point
+	void backToFront(const Vertex& eye, bool orthographic, QVector<int>& order, QVector<int>& stack) const;
+	int objectVertexCount() const { return objectVertices; }
+	const QVector<Vertex>& getVertices() const { return vertices; }
+	const BspTriangle& triangle(int i) const { return triangles[i]; }
+	qint64 memoryBytes() const {
+		return vertices.capacity() * sizeof(Vertex) + triangles.capacity() * sizeof(BspTriangle) + nodeTriangles.capacity() * sizeof(int) + nodes.capacity() * sizeof(BspNode);
+	}
+};
@@ -0,0 +1,98 @@
+#include "CurveTessellation.h"
+
+//limits keep degenerate input (huge coordinates, zero tolerance) from running away
+static const int MAX_CUBIC_SEGMENTS = 1024;
+static const int MAX_SUBDIVISION_DEPTH = 16;
+
+int cubicSegmentCount(const QPointF& P0, const QPointF& P1, const QPointF& P2, const QPointF& P3, double tolerance) {
+	//maximal length of second differences of control polygon bounds curvature of segment
+	QPointF D1 = P0 - 2 * P1 + P2;
+	QPointF D2 = P1 - 2 * P2 + P3;
+	double M = std::max(std::hypot(D1.x(), D1.y()), std::hypot(D2.x(), D2.y()));
+	if (tolerance <= 0) {
+		return MAX_CUBIC_SEGMENTS;
+	}
+	int n = static_cast<int>(std::ceil(std::sqrt(0.75 * M / tolerance)));
+	return std::min(std::max(n, 1), MAX_CUBIC_SEGMENTS);
+}
+void flattenCubicBezier(const QPointF& P0, const QPointF& P1, const QPointF& P2, const QPointF& P3, double tolerance, QVector<QPointF>& polyline) {
+	int n = cubicSegmentCount(P0, P1, P2, P3, tolerance);
+	//polynomial coefficients of curve a*t^3 + b*t^2 + c*t + P0
+	QPointF a = -P0 + 3 * P1 - 3 * P2 + P3;
+	QPointF b = 3 * P0 - 6 * P1 + 3 * P2;
+	QPointF c = -3 * P0 + 3 * P1;
+	double h = 1.0 / n;
+	double h2 = h * h;
+	double h3 = h2 * h;
+	//forward differences, each step costs three additions
+	QPointF point = P0;
+	QPointF d1 = a * h3 + b * h2 + c * h;
+	QPointF d2 = 6 * a * h3 + 2 * b * h2;
+	QPointF d3 = 6 * a * h3;
+	for (int i = 1; i < n; i++) {
+		point += d1;
+		d1 += d2;
+		d2 += d3;
+		polyline.append(point);
+	}
+	//end point is appended exactly so rounding errors don't accumulate between segments
+	polyline.append(P3);
+}
+void flattenHermiteSegment(const QPointF& P0, const QPointF& T0, const QPointF& P1, const QPointF& T1, double tolerance, QVector<QPointF>& polyline) {
+	flattenCubicBezier(P0, P0 + T0 / 3, P1 - T1 / 3, P1, tolerance, polyline);
+}
+void flattenCoonsSegment(const QPointF& P0, const QPointF& P1, const QPointF& P2, const QPointF& P3, double tolerance, QVector<QPointF>& polyline) {
+	//conversion of uniform B-spline segment to Bezier control points
+	QPointF B0 = (P0 + 4 * P1 + P2) / 6;
+	QPointF B1 = (2 * P1 + P2) / 3;
+	QPointF B2 = (P1 + 2 * P2) / 3;
+	QPointF B3 = (P1 + 4 * P2 + P3) / 6;
+	flattenCubicBezier(B0, B1, B2, B3, tolerance, polyline);
+}
+
+//curve lies in convex hull of its control points, so it is flat when every control point is close to the chord
+static bool isControlPolygonFlat(const QPointF* P, int n, double tolerance) {
+	QPointF chord = P[n - 1] - P[0];
+	double chordLengthSquared = QPointF::dotProduct(chord, chord);
+	for (int i = 1; i < n - 1; i++) {
+		QPointF v = P[i] - P[0];
+		double t = chordLengthSquared > 0 ? std::clamp(QPointF::dotProduct(v, chord) / chordLengthSquared, 0.0, 1.0) : 0.0;
+		QPointF distance = v - t * chord;
+		if (QPointF::dotProduct(distance, distance) > tolerance * tolerance) {
+			return false;
+		}
+	}
+	return true;
+}
+//curve holds n control points and is overwritten by left half, right half is stored in scratch,
+//deeper levels of recursion use following n points of scratch
+static void subdivideBezier(QPointF* curve, int n, int depth, double tolerance, QPointF* scratch, QVector<QPointF>& polyline) {
+	if (depth >= MAX_SUBDIVISION_DEPTH || isControlPolygonFlat(curve, n, tolerance)) {
+		polyline.append(curve[n - 1]);
+		return;
+	}
+	QPointF* right = scratch;
+	//de Casteljau in t = 0.5 computed backwards, so curve[k] keeps first point of level k
+	right[n - 1] = curve[n - 1];
+	for (int k = 1; k < n; k++) {
+		for (int j = n - 1; j >= k; j--) {
+			curve[j] = (curve[j - 1] + curve[j]) * 0.5;
+		}
+		right[n - 1 - k] = curve[n - 1];
+	}
+	subdivideBezier(curve, n, depth + 1, tolerance, scratch + n, polyline);
+	subdivideBezier(right, n, depth + 1, tolerance, scratch + n, polyline);
+}
+void flattenBezier(const QVector<QPoint>& controlPoints, double tolerance, QVector<QPointF>& scratch, QVector<QPointF>& polyline) {
+	int n = controlPoints.length();
+	if (n < 2) {
+		return;
+	}
+	//one block of n points for the curve itself and one for every level of subdivision
+	scratch.resize((MAX_SUBDIVISION_DEPTH + 2) * n);
+	QPointF* curve = scratch.data();
+	for (int i = 0; i < n; i++) {
+		curve[i] = controlPoints[i];
+	}
+	subdivideBezier(curve, n, 0, tolerance, curve + n, polyline);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <QPoint>
+#include <QVector>
+#include <QPointF>
+
+//Adaptive flattening of curves into polylines.
+//Tolerance is maximal distance in pixels between curve and its polyline, number of points follows screen size of curve.
+//All functions append points of curve after its start point, caller begins polyline with the start point.
+
+//Number of forward differencing steps for cubic Bezier segment (Wang's formula)
+int cubicSegmentCount(const QPointF& P0, const QPointF& P1, const QPointF& P2, const QPointF& P3, double tolerance);
+//Cubic Bezier segment evaluated by forward differencing
+void flattenCubicBezier(const QPointF& P0, const QPointF& P1, const QPointF& P2, const QPointF& P3, double tolerance, QVector<QPointF>& polyline);
+//Hermite segment, tangents are given as vectors (end of tangent - control point)
+void flattenHermiteSegment(const QPointF& P0, const QPointF& T0, const QPointF& P1, const QPointF& T1, double tolerance, QVector<QPointF>& polyline);
+//Segment of uniform cubic B-spline (Coons) defined by four consecutive control points
+void flattenCoonsSegment(const QPointF& P0, const QPointF& P1, const QPointF& P2, const QPointF& P3, double tolerance, QVector<QPointF>& polyline);
+//Bezier curve of any degree, subdivided until control polygon is flat, scratch is reused between calls
+void flattenBezier(const QVector<QPoint>& controlPoints, double tolerance, QVector<QPointF>& scratch, QVector<QPointF>& polyline);
@@ -0,0 +1,190 @@
+#pragma once
+#include <QVector>
+#include <QString>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QTextStream>
+
+enum class ProfileStage { Transform, Cull, Setup, Raster, Shade, Count };
+
+//Times and counters of one drawn frame, times are in nanoseconds from start of profiling
+struct ProfileFrame {
+	qint64 start = 0;
+	qint64 duration = 0;
+	qint64 stageTime[static_cast<int>(ProfileStage::Count)] = {};
+	//first and last moment of every stage, stages running in chunks are shown as one span in trace
+	qint64 stageBegin[static_cast<int>(ProfileStage::Count)] = {};
+	qint64 stageEnd[static_cast<int>(ProfileStage::Count)] = {};
+	//triangles of drawn object, drawn ones survived culling of clusters and triangles and went to rasterizer
+	qint64 trianglesSubmitted = 0;
+	qint64 trianglesDrawn = 0;
+	qint64 pixelsShaded = 0;
+	qint64 zTestFailed = 0;
+	//triangles of clusters and objects hidden behind hierarchical depth, pixels skipped by its blocks
+	qint64 trianglesOccluded = 0;
+	qint64 pixelsBlockRejected = 0;
+	//pixels covered by frame, overdraw is shaded pixels per covered pixel
+	qint64 pixelsCovered = 0;
+	//bytes held for visibility of surface, Z-buffer with hierarchical depth, sorted triangles or BSP tree
+	qint64 visibilityBytes = 0;
+
+	double stageMs(ProfileStage stage) const { return stageTime[static_cast<int>(stage)] / 1e6; }
+	double overdraw() const { return pixelsCovered > 0 ? static_cast<double>(pixelsShaded) / pixelsCovered : 0; }
+};
+
+//Per-stage frame profiler of Renderer, disabled profiler costs one branch per scope.
+//Last frames are kept in ring so they can be exported as Chrome trace-event JSON (chrome://tracing, Perfetto)
+class FrameProfiler {
+private:
+	bool enabled = false;
+	QElapsedTimer clock;
+	ProfileFrame current;
+	bool frameOpen = false;
+	QVector<ProfileFrame> history;
+	int historyNext = 0;
+	int historyLimit = 600;
+	//covered pixels are counted by scan of Z-buffer after surface frame, timing runs turn it off so scan isn't part of frame time
+	bool pixelCounting = true;
+
+public:
+	static const char* stageName(ProfileStage stage) {
+		static const char* names[] = { "Transform", "Cull", "Setup", "Raster", "Shade" };
+		return names[static_cast<int>(stage)];
+	}
+
+	void setEnabled(bool state) {
+		enabled = state;
+		if (enabled && !clock.isValid()) {
+			clock.start();
+		}
+		//ring is allocated at once, so profiled frames don't grow it
+		if (enabled) {
+			history.reserve(historyLimit);
+		}
+	}
+	bool isEnabled() const { return enabled; }
+	void setPixelCounting(bool state) { pixelCounting = state; }
+	bool isPixelCounting() const { return pixelCounting; }
+	qint64 now() const { return clock.nsecsElapsed(); }
+
+	void beginFrame() {
+		if (!enabled) {
+			return;
+		}
+		current = ProfileFrame();
+		current.start = now();
+		frameOpen = true;
+	}
+	void endFrame() {
+		if (!enabled || !frameOpen) {
+			return;
+		}
+		current.duration = now() - current.start;
+		frameOpen = false;
+		if (history.length() < historyLimit) {
+			history.append(current);
+		}
+		else {
+			history[historyNext] = current;
+		}
+		historyNext = (historyNext + 1) % historyLimit;
+	}
+	void addStageTime(ProfileStage stage, qint64 begin, qint64 end) {
+		int index = static_cast<int>(stage);
+		if (current.stageTime[index] == 0) {
+			current.stageBegin[index] = begin;
+		}
+		current.stageTime[index] += end - begin;
+		current.stageEnd[index] = end;
+	}
+	ProfileFrame& frame() { return current; }
+	//last finished frame, empty when nothing was profiled yet
+	ProfileFrame lastFrame() const {
+		if (history.isEmpty()) {
+			return ProfileFrame();
+		}
+		return history[(historyNext + historyLimit - 1) % historyLimit];
+	}
+	void clearHistory() {
+		history.resize(0);
+		historyNext = 0;
+	}
+	//Lines of overlay text describing last frame
+	QStringList summary() const {
+		ProfileFrame frame = lastFrame();
+		QStringList lines;
+		lines << QString("frame %1 ms").arg(frame.duration / 1e6, 0, 'f', 2);
+		for (int i = 0; i < static_cast<int>(ProfileStage::Count); i++) {
+			lines << QString("%1 %2 ms").arg(stageName(static_cast<ProfileStage>(i))).arg(frame.stageMs(static_cast<ProfileStage>(i)), 0, 'f', 2);
+		}
+		lines << QString("triangles %1 / %2").arg(frame.trianglesDrawn).arg(frame.trianglesSubmitted);
+		lines << QString("pixels shaded %1").arg(frame.pixelsShaded);
+		lines << QString("z-test failed %1").arg(frame.zTestFailed);
+		lines << QString("occluded triangles %1, block rejected pixels %2").arg(frame.trianglesOccluded).arg(frame.pixelsBlockRejected);
+		lines << QString("overdraw %1").arg(frame.overdraw(), 0, 'f', 2);
+		lines << QString("visibility memory %1 KB").arg(frame.visibilityBytes / 1024.0, 0, 'f', 1);
+		return lines;
+	}
+	//Writes kept frames as trace events, frame and stages are complete events, counters are counter events
+	bool writeChromeTrace(const QString& filename) const {
+		QFile file(filename);
+		if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+			return false;
+		}
+		QTextStream out(&file);
+		out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+		out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Renderer\"}}";
+		//ring is written from oldest frame
+		int first = history.length() < historyLimit ? 0 : historyNext;
+		for (int n = 0; n < history.length(); n++) {
+			const ProfileFrame& frame = history[(first + n) % history.length()];
+			//trace timestamps are in microseconds
+			out << QString(",\n{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%1,\"dur\":%2}").arg(frame.start / 1e3, 0, 'f', 3).arg(frame.duration / 1e3, 0, 'f', 3);
+			for (int i = 0; i < static_cast<int>(ProfileStage::Count); i++) {
+				if (frame.stageTime[i] == 0) {
+					continue;
+				}
+				out << QString(",\n{\"name\":\"%1\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%2,\"dur\":%3,\"args\":{\"busy_ms\":%4}}")
+					.arg(stageName(static_cast<ProfileStage>(i))).arg(frame.stageBegin[i] / 1e3, 0, 'f', 3)
+					.arg((frame.stageEnd[i] - frame.stageBegin[i]) / 1e3, 0, 'f', 3).arg(frame.stageTime[i] / 1e6, 0, 'f', 3);
+			}
+			out << QString(",\n{\"name\":\"Triangles\",\"ph\":\"C\",\"pid\":1,\"ts\":%1,\"args\":{\"submitted\":%2,\"drawn\":%3}}")
+				.arg(frame.start / 1e3, 0, 'f', 3).arg(frame.trianglesSubmitted).arg(frame.trianglesDrawn);
+			out << QString(",\n{\"name\":\"Pixels\",\"ph\":\"C\",\"pid\":1,\"ts\":%1,\"args\":{\"shaded\":%2,\"z_test_failed\":%3,\"block_rejected\":%4}}")
+				.arg(frame.start / 1e3, 0, 'f', 3).arg(frame.pixelsShaded).arg(frame.zTestFailed).arg(frame.pixelsBlockRejected);
+			out << QString(",\n{\"name\":\"Occluded\",\"ph\":\"C\",\"pid\":1,\"ts\":%1,\"args\":{\"triangles\":%2}}")
+				.arg(frame.start / 1e3, 0, 'f', 3).arg(frame.trianglesOccluded);
+			out << QString(",\n{\"name\":\"Overdraw\",\"ph\":\"C\",\"pid\":1,\"ts\":%1,\"args\":{\"ratio\":%2}}")
+				.arg(frame.start / 1e3, 0, 'f', 3).arg(frame.overdraw(), 0, 'f', 3);
+			out << QString(",\n{\"name\":\"Memory\",\"ph\":\"C\",\"pid\":1,\"ts\":%1,\"args\":{\"visibility_bytes\":%2}}")
+				.arg(frame.start / 1e3, 0, 'f', 3).arg(frame.visibilityBytes);
+		}
+		out << "\n]}\n";
+		file.close();
+		return true;
+	}
+};
+
+//Scoped timer, adds time spent in its scope to stage of current frame
+class ProfileScope {
+private:
+	FrameProfiler& profiler;
+	ProfileStage stage;
+	bool active;
+	qint64 begin = 0;
+
+public:
+	ProfileScope(FrameProfiler& profiler, ProfileStage stage) : profiler(profiler), stage(stage), active(profiler.isEnabled()) {
+		if (active) {
+			begin = profiler.now();
+		}
+	}
+	~ProfileScope() {
+		if (active && profiler.isEnabled()) {
+			profiler.addStageTime(stage, begin, profiler.now());
+		}
+	}
+	ProfileScope(const ProfileScope&) = delete;
+	ProfileScope& operator=(const ProfileScope&) = delete;
+};
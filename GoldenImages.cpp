@@ -0,0 +1,402 @@
+//Golden-image regression check, renders fixed corpus headlessly and compares it with stored reference images
+//usage: GoldenImages [--references dir] [--output dir] [--tolerance 2] [--update] [scene1.txt scene2.txt ...]
+//run with --update once on trusted build to store references, every later run reports images which differ from them.
+//Hierarchy of 3D scene refit after moving objects is checked against hierarchy built from scratch as well
+#include "Renderer.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <functional>
+#include <cfloat>
+
+//One image of corpus, draw gets cleared renderer of given size.
+//Case with reference set must draw same image as that case, it has no reference image of its own
+struct GoldenCase {
+	QString name;
+	QSize size;
+	std::function<void(Renderer&)> draw;
+	QString reference;
+};
+
+//Returns number of pixels which differ by more than tolerance in some channel,
+//diff shows them red over dimmed reference
+static int compareImages(const QImage& actual, const QImage& reference, int tolerance, QImage& diff) {
+	if (actual.size() != reference.size()) {
+		diff = actual;
+		return actual.width() * actual.height();
+	}
+	QImage expected = reference.convertToFormat(QImage::Format_ARGB32);
+	diff = QImage(actual.size(), QImage::Format_ARGB32);
+	int failed = 0;
+	for (int y = 0; y < actual.height(); y++) {
+		const QRgb* actualRow = reinterpret_cast<const QRgb*>(actual.constScanLine(y));
+		const QRgb* expectedRow = reinterpret_cast<const QRgb*>(expected.constScanLine(y));
+		QRgb* diffRow = reinterpret_cast<QRgb*>(diff.scanLine(y));
+		for (int x = 0; x < actual.width(); x++) {
+			QRgb a = actualRow[x];
+			QRgb e = expectedRow[x];
+			int difference = std::max({ abs(qRed(a) - qRed(e)), abs(qGreen(a) - qGreen(e)), abs(qBlue(a) - qBlue(e)), abs(qAlpha(a) - qAlpha(e)) });
+			if (difference > tolerance) {
+				diffRow[x] = qRgb(255, 0, 0);
+				failed++;
+			}
+			else {
+				int gray = 128 + qGray(e) / 2;
+				diffRow[x] = qRgb(gray, gray, gray);
+			}
+		}
+	}
+	return failed;
+}
+
+//Scene text exercising every 2D object type, it is read by readSceneState like scene files saved by viewer
+static const char* builtinScene =
+	"MODELVIEWER 2D SCENE FORMAT\n"
+	"SIZE:400:300\n"
+	"TYPE:polygon\nNAME:scanline\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:40:120:220\nFILLING_ALG:1\nCURVE_TYPE:0\nLAYER:0\nPOINTS:5\n20:20\n180:40\n150:140\n90:90\n30:150\n\n"
+	"TYPE:polygon\nNAME:outline\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:200:40:40\nFILLING_ALG:0\nCURVE_TYPE:0\nLAYER:1\nPOINTS:4\n200:20\n380:30\n360:130\n210:120\n\n"
+	"TYPE:polygon\nNAME:triangle_nearest\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:30:160:60\nFILLING_ALG:2\nCURVE_TYPE:0\nLAYER:2\nPOINTS:3\n40:280\n140:170\n190:270\n\n"
+	"TYPE:polygon\nNAME:triangle_baricentric\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:220:160:30\nFILLING_ALG:3\nCURVE_TYPE:0\nLAYER:3\nPOINTS:3\n210:290\n300:160\n390:260\n\n"
+	"TYPE:line\nNAME:line\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:0:0:0\nFILLING_ALG:0\nCURVE_TYPE:0\nLAYER:4\nPOINTS:2\n10:295\n395:5\n\n"
+	"TYPE:circle\nNAME:circle\nOUTLINE_COLOR:120:0:160\nFILLING_COLOR:0:0:0\nFILLING_ALG:0\nCURVE_TYPE:0\nLAYER:5\nPOINTS:2\n200:150\n260:190\n\n"
+	"TYPE:curve\nNAME:hermite\nOUTLINE_COLOR:0:90:0\nFILLING_COLOR:0:0:0\nFILLING_ALG:0\nCURVE_TYPE:0\nLAYER:6\nPOINTS:3\n20:200:80:160\n120:230:160:260\n220:200:260:170\n\n"
+	"TYPE:curve\nNAME:bezier\nOUTLINE_COLOR:160:0:0\nFILLING_COLOR:0:0:0\nFILLING_ALG:0\nCURVE_TYPE:1\nLAYER:7\nPOINTS:4\n220:60:0:0\n260:0:0:0\n320:140:0:0\n390:80:0:0\n\n"
+	"TYPE:curve\nNAME:coons\nOUTLINE_COLOR:0:0:160\nFILLING_COLOR:0:0:0\nFILLING_ALG:0\nCURVE_TYPE:2\nLAYER:8\nPOINTS:5\n20:60:0:0\n80:10:0:0\n140:80:0:0\n200:20:0:0\n260:90:0:0\n\n"
+	"TYPE:ellipse\nNAME:ellipse\nOUTLINE_COLOR:0:120:120\nFILLING_COLOR:0:0:0\nFILLING_ALG:0\nCURVE_TYPE:0\nLAYER:9\nPOINTS:2\n300:230\n380:270\n\n"
+	"TYPE:ellipse\nNAME:ellipse_filled\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:230:120:180\nFILLING_ALG:1\nCURVE_TYPE:0\nLAYER:10\nPOINTS:2\n90:250\n150:280\n\n"
+	"TYPE:ellipse\nNAME:ellipse_clipped\nOUTLINE_COLOR:0:0:0\nFILLING_COLOR:90:90:200\nFILLING_ALG:1\nCURVE_TYPE:0\nLAYER:11\nPOINTS:2\n390:150\n420:40\n\n";
+
+//Line algorithms and polygon fillers called directly, same picture is drawn once aliased and once anti-aliased
+static void drawPrimitives(Renderer& renderer, int lineAlgType) {
+	QPoint center(150, 150);
+	for (int i = 0; i < 24; i++) {
+		double angle = 2 * M_PI * i / 24;
+		QPoint end = center + QPoint(static_cast<int>(round(140 * cos(angle))), static_cast<int>(round(140 * sin(angle))));
+		renderer.drawLine(center, end, QColor(0, 0, 0), lineAlgType);
+	}
+	renderer.drawCircle(QPoint(340, 70), 50, QColor(200, 0, 0));
+	renderer.drawCircle(QPoint(340, 220), 40, QColor(0, 120, 200), true);
+	renderer.drawEllipse(QPoint(250, 40), 70, 25, QColor(0, 120, 120));
+	renderer.drawEllipse(QPoint(250, 110), 30, 60, QColor(230, 120, 180), true);
+	//ellipse crossing image border is clipped per pixel and per span
+	renderer.drawEllipse(QPoint(380, 380), 60, 40, QColor(90, 90, 200));
+	renderer.drawEllipse(QPoint(-10, 200), 40, 70, QColor(200, 160, 0), true);
+	renderer.drawPolygon({ QPoint(310, 280), QPoint(390, 270), QPoint(380, 340), QPoint(340, 300), QPoint(300, 345) }, QColor(40, 160, 60), lineAlgType, 1);
+	renderer.drawPolygon({ QPoint(20, 310), QPoint(140, 300), QPoint(90, 390) }, QColor(220, 120, 0), lineAlgType, 1);
+	//polygon crossing image border goes thru clipping
+	renderer.drawPolygon({ QPoint(180, 320), QPoint(460, 330), QPoint(260, 460) }, QColor(120, 0, 160), lineAlgType, 1);
+}
+
+//Box around bounding spheres of objects in run of hierarchy, same box as full build gives to node over that run
+static void sceneRunBounds(const Scene3D& scene, int first, int count, Vertex& minimum, Vertex& maximum) {
+	minimum = Vertex(DBL_MAX, DBL_MAX, DBL_MAX);
+	maximum = Vertex(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	for (int i = first; i < first + count; i++) {
+		const Vertex& center = scene.objectCenter(scene.getNodeObjects()[i]);
+		double radius = scene.objectRadius(scene.getNodeObjects()[i]);
+		minimum = Vertex(std::min(minimum.x, center.x - radius), std::min(minimum.y, center.y - radius), std::min(minimum.z, center.z - radius));
+		maximum = Vertex(std::max(maximum.x, center.x + radius), std::max(maximum.y, center.y + radius), std::max(maximum.z, center.z + radius));
+	}
+}
+
+//Moves some objects of built scene by setPlacement and compares its refit hierarchy with scene built from scratch with same placements.
+//Every node has to bound exactly objects under it, root has to match root of full build and both have to see same objects.
+//Returns number of mismatches
+static int checkSceneRefit() {
+	auto cubeMesh = []() {
+		QString vtk;
+		QTextStream out(&vtk);
+		writeCubeVTK(out, 20);
+		out.flush();
+		QTextStream in(&vtk);
+		return readPolygonsVTK(in);
+	};
+	auto placement = [](int object, bool moved) {
+		ObjectInstance instance;
+		instance.translation = Vertex((object % 8) * 60 - 210, (object / 8) * 60 - 210, (object % 5) * 20);
+		instance.rotationY = object * 0.3;
+		instance.scale = 1 + (object % 3) * 0.5;
+		if (moved) {
+			instance.translation = Vertex(instance.translation.x + 500, instance.translation.y - 300, instance.translation.z + 200);
+			instance.scale *= 2;
+		}
+		return instance;
+	};
+	const int objectCount = 64;
+	auto isMoved = [](int object) { return object == 0 || object == 17 || object == 63; };
+	Scene3D refit;
+	Scene3D rebuilt;
+	int refitMesh = refit.addMesh(cubeMesh());
+	int rebuiltMesh = rebuilt.addMesh(cubeMesh());
+	for (int i = 0; i < objectCount; i++) {
+		refit.addObject(refitMesh, placement(i, false));
+		rebuilt.addObject(rebuiltMesh, placement(i, isMoved(i)));
+	}
+	refit.buildHierarchy();
+	for (int i = 0; i < objectCount; i++) {
+		if (isMoved(i)) {
+			refit.setPlacement(i, placement(i, true));
+		}
+	}
+	rebuilt.buildHierarchy();
+
+	int mismatches = 0;
+	for (const SceneNode& node : refit.getNodes()) {
+		Vertex minimum, maximum;
+		sceneRunBounds(refit, node.first, node.count, minimum, maximum);
+		if (!(node.minimum == minimum) || !(node.maximum == maximum)) {
+			mismatches++;
+		}
+	}
+	const SceneNode& refitRoot = refit.getNodes().first();
+	const SceneNode& rebuiltRoot = rebuilt.getNodes().first();
+	if (!(refitRoot.minimum == rebuiltRoot.minimum) || !(refitRoot.maximum == rebuiltRoot.maximum)) {
+		mismatches++;
+	}
+	//half-spaces cutting through scene, walk of refit hierarchy has to keep every object full build keeps
+	QVector<int> refitVisible;
+	QVector<int> rebuiltVisible;
+	for (double limit = -300; limit <= 800; limit += 50) {
+		auto outside = [limit](const Vertex& center, double radius) { return center.x + center.y + radius * M_SQRT2 < limit; };
+		refit.collectVisible(outside, refitVisible);
+		rebuilt.collectVisible(outside, rebuiltVisible);
+		std::sort(refitVisible.begin(), refitVisible.end());
+		std::sort(rebuiltVisible.begin(), rebuiltVisible.end());
+		if (refitVisible != rebuiltVisible) {
+			mismatches++;
+		}
+	}
+	refit.clear();
+	rebuilt.clear();
+	return mismatches;
+}
+
+int main(int argc, char* argv[])
+{
+	QLocale::setDefault(QLocale::c());
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("GoldenImages");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Renders fixed corpus of 2D scenes and 3D objects and compares it with reference images.");
+	parser.addHelpOption();
+	parser.addPositionalArgument("scenes", "Additional 2D scene files saved by viewer.", "[scenes...]");
+	QCommandLineOption referencesOption({ "r", "references" }, "Directory of reference images.", "dir", "golden");
+	QCommandLineOption outputOption({ "o", "output" }, "Directory for actual and diff images of failed comparisons.", "dir", "golden_failed");
+	QCommandLineOption toleranceOption("tolerance", "Largest accepted difference of one channel.", "value", "2");
+	QCommandLineOption updateOption("update", "Stores rendered images as new references.");
+	parser.addOptions({ referencesOption, outputOption, toleranceOption, updateOption });
+	parser.process(app);
+
+	QDir references(parser.value(referencesOption));
+	QDir output(parser.value(outputOption));
+	int tolerance = std::max(parser.value(toleranceOption).toInt(), 0);
+	bool update = parser.isSet(updateOption);
+	if (!QDir().mkpath(output.path()) || (update && !QDir().mkpath(references.path()))) {
+		qDebug() << "output directory can't be created";
+		return 1;
+	}
+
+	//3D corpus, generated meshes are kept for all cases
+	Object_H_edge cube;
+	Object_H_edge sphere;
+	{
+		QString vtk;
+		QTextStream out(&vtk);
+		writeCubeVTK(out, 110);
+		out.flush();
+		QTextStream in(&vtk);
+		cube = readPolygonsVTK(in);
+	}
+	{
+		QString vtk;
+		QTextStream out(&vtk);
+		writeUvSphereVTK(out, 150, 16, 16, 0);
+		out.flush();
+		QTextStream in(&vtk);
+		sphere = readPolygonsVTK(in);
+	}
+	LightSettings light(Vertex(500, 500, 100), 0.5, 0.5, 0.5, 1, QColor(255, 255, 255), QColor(0, 0, 255));
+
+	QVector<GoldenCase> cases;
+	struct Mode {
+		QString name;
+		int representationType;
+		int fillingAlgType;
+		bool lit;
+		bool hiddenLines;
+		bool frontToBack;
+		bool depthPrepass;
+		bool occlusionCulling;
+		//mode which must give same image, only order of work or culling differs (triangles tied in depth on shared edge may swap, within tolerance)
+		QString sameAs;
+	};
+	//same codes as combo boxes of viewer, lit surface is Gouraud with filling 1 and nearest neighbour otherwise
+	const QVector<Mode> modes = {
+		{ "wireframe", 0, 0, false, false, false, false, true, "" },
+		{ "wireframe_hidden", 0, 0, false, true, false, false, true, "" },
+		{ "flat", 1, 0, false, false, false, false, true, "" },
+		{ "gouraud", 1, 1, true, false, false, false, true, "" },
+		{ "nearest", 1, 0, true, false, false, false, true, "" },
+		{ "painter", 2, 1, true, false, false, false, true, "" },
+		{ "bsp", 3, 1, true, false, false, false, true, "" },
+		{ "flat_front_to_back", 1, 0, false, false, true, false, true, "flat" },
+		{ "gouraud_front_to_back", 1, 1, true, false, true, false, true, "gouraud" },
+		{ "gouraud_prepass", 1, 1, true, false, false, true, true, "gouraud" },
+		{ "gouraud_front_to_back_prepass", 1, 1, true, false, true, true, true, "gouraud" },
+		{ "flat_no_occlusion", 1, 0, false, false, false, false, false, "flat" },
+		{ "gouraud_no_occlusion", 1, 1, true, false, false, false, false, "gouraud" },
+		{ "gouraud_front_to_back_no_occlusion", 1, 1, true, false, true, false, false, "gouraud" },
+		{ "gouraud_prepass_no_occlusion", 1, 1, true, false, false, true, false, "gouraud" },
+	};
+	struct GoldenMesh {
+		QString name;
+		const Object_H_edge* object;
+		//copies drawn instead of object, object is made current object of renderer for them
+		QVector<ObjectInstance> instances;
+	};
+	//row of sphere copies going away from viewer, each partly hides next one, so occlusion culling rejects copies and their clusters
+	QVector<ObjectInstance> sphereRow;
+	{
+		ProjectionPlane plane(M_PI / 6, M_PI / 3, Vertex());
+		const Vertex& N = plane.basisVectorN;
+		const Vertex& U = plane.basisVectorU;
+		const Vertex& V = plane.basisVectorV;
+		for (int i = 0; i < 4; i++) {
+			double n = -150.0 * i, v = 60.0 * i - 90, u = 20.0 * i - 30;
+			ObjectInstance instance;
+			instance.translation = Vertex(N.x * n + V.x * v + U.x * u, N.y * n + V.y * v + U.y * u, N.z * n + V.z * v + U.z * u);
+			instance.scale = 0.6;
+			sphereRow.append(instance);
+		}
+	}
+	const QVector<GoldenMesh> meshes = { { "cube", &cube, {} }, { "sphere", &sphere, {} }, { "sphere_row", &sphere, sphereRow } };
+	for (const GoldenMesh& mesh : meshes) {
+		for (int projectionType = 0; projectionType < 2; projectionType++) {
+			for (const Mode& mode : modes) {
+				const Object_H_edge* object = mesh.object;
+				const QVector<ObjectInstance> instances = mesh.instances;
+				GoldenCase golden;
+				QString prefix = QString("%1_%2_").arg(mesh.name).arg(projectionType == 0 ? "orthogonal" : "perspective");
+				golden.name = prefix + mode.name;
+				golden.reference = mode.sameAs.isEmpty() ? QString() : prefix + mode.sameAs;
+				golden.size = QSize(400, 400);
+				golden.draw = [object, instances, projectionType, mode, &light](Renderer& renderer) {
+					renderer.invalidateProjection();
+					renderer.setHiddenLineRemoval(mode.hiddenLines);
+					renderer.setFrontToBack(mode.frontToBack);
+					renderer.setDepthPrepass(mode.depthPrepass);
+					renderer.setOcclusionCulling(mode.occlusionCulling);
+					renderer.getCamera().position.z = 1000;
+					renderer.getProjectionPlane().setProjectionPlane(M_PI / 6, M_PI / 3);
+					if (instances.isEmpty()) {
+						renderer.drawObject(*object, projectionType, mode.representationType, mode.fillingAlgType, mode.lit ? &light : nullptr);
+						return;
+					}
+					//renderer doesn't free its current object, mesh stays owned by corpus
+					renderer.setCurrentObject(Object_H_edge(*object));
+					renderer.setInstances(instances);
+					renderer.drawObject(renderer.getCurrentObject(), projectionType, mode.representationType, mode.fillingAlgType, mode.lit ? &light : nullptr);
+					renderer.setInstances(QVector<ObjectInstance>());
+					renderer.setCurrentObject(Object_H_edge());
+				};
+				cases.append(golden);
+			}
+		}
+	}
+
+	//2D corpus
+	for (int antialiasing = 0; antialiasing < 2; antialiasing++) {
+		for (int lineAlgType = 0; lineAlgType < 2; lineAlgType++) {
+			//Wu replaces both line algorithms when anti-aliased
+			if (antialiasing && lineAlgType == 1) {
+				continue;
+			}
+			GoldenCase golden;
+			golden.name = antialiasing ? QString("primitives_antialiased") : QString("primitives_%1").arg(lineAlgType == 0 ? "dda" : "bresenham");
+			golden.size = QSize(400, 400);
+			golden.draw = [antialiasing, lineAlgType](Renderer& renderer) {
+				renderer.setAntialiasing(antialiasing);
+				drawPrimitives(renderer, lineAlgType);
+			};
+			cases.append(golden);
+		}
+	}
+	QVector<QPair<QString, QString>> sceneTexts = { { "scene_builtin", builtinScene } };
+	for (const QString& fileName : parser.positionalArguments()) {
+		QFile file(fileName);
+		if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+			qDebug() << fileName << " : file failed to open";
+			return 1;
+		}
+		sceneTexts.append({ "scene_" + QFileInfo(fileName).completeBaseName(), QTextStream(&file).readAll() });
+	}
+	for (const QPair<QString, QString>& sceneText : sceneTexts) {
+		QString text = sceneText.second;
+		QTextStream in(&text);
+		QSize size;
+		QMap<QString, Object2D> objects;
+		if (!readSceneState(in, size, objects) || objects.isEmpty()) {
+			qDebug() << sceneText.first << " : wrong format of scene";
+			return 1;
+		}
+		for (int antialiasing = 0; antialiasing < 2; antialiasing++) {
+			GoldenCase golden;
+			golden.name = sceneText.first + (antialiasing ? "_antialiased" : "");
+			golden.size = size;
+			golden.draw = [objects, antialiasing](Renderer& renderer) {
+				renderer.setAntialiasing(antialiasing);
+				renderer.drawObjects2D(objects);
+			};
+			cases.append(golden);
+		}
+	}
+
+	int failedCases = 0;
+	for (const GoldenCase& golden : cases) {
+		Renderer renderer(golden.size);
+		renderer.clear();
+		golden.draw(renderer);
+		QImage actual = renderer.getImage()->copy();
+		QString referenceName = references.filePath((golden.reference.isEmpty() ? golden.name : golden.reference) + ".png");
+		//case drawing same image as other one is compared with its reference, which is written earlier in update
+		if (update && golden.reference.isEmpty()) {
+			if (!actual.save(referenceName, "PNG")) {
+				qDebug() << referenceName << " : image failed to save";
+				failedCases++;
+			}
+			continue;
+		}
+		QImage reference;
+		if (!reference.load(referenceName)) {
+			qDebug() << golden.name << " : reference is missing";
+			actual.save(output.filePath(golden.name + "_actual.png"), "PNG");
+			failedCases++;
+			continue;
+		}
+		QImage diff;
+		int failedPixels = compareImages(actual, reference, tolerance, diff);
+		if (failedPixels > 0) {
+			qDebug() << golden.name << " : " << failedPixels << " pixels differ";
+			actual.save(output.filePath(golden.name + "_actual.png"), "PNG");
+			diff.save(output.filePath(golden.name + "_diff.png"), "PNG");
+			failedCases++;
+		}
+	}
+	cube.release();
+	sphere.release();
+	int sceneMismatches = checkSceneRefit();
+	if (sceneMismatches > 0) {
+		qDebug() << "scene hierarchy : " << sceneMismatches << " mismatches after refit";
+	}
+	if (update) {
+		qDebug() << cases.length() - failedCases << " references written";
+	}
+	else {
+		qDebug() << cases.length() - failedCases << " / " << cases.length() << " images match";
+	}
+	return failedCases == 0 && sceneMismatches == 0 ? 0 : 1;
+}
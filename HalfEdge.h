@@ -0,0 +1,197 @@
+#pragma once
+
+#include <QVector>
+#include <QVector3D>
+#include <QHash>
+#include <QPair>
+#include <QColor>
+#include <QPoint>
+#include <QString>
+#include <QDebug>
+
+//Half-edge mesh of 3D object and its VTK input and output, shared by renderer, scene and mesh modules
+
+class H_edge;
+
+class Vertex {
+public:
+	double x = 0, y = 0, z = 0;
+	H_edge* edge = nullptr;
+
+	Vertex() {}
+	Vertex(double x, double y, double z) : x(x), y(y), z(z), edge(nullptr) {};
+
+	QString toString() {
+		return "Vertex({" + QString::number(x) + ", " + QString::number(y) + ", " + QString::number(z) + "})";
+	}
+	QPoint toQPointXY() { return QPoint(static_cast<int> (x), static_cast<int> (y)); }
+
+	QVector3D toQVector3D() const { 
+		QVector3D vector;
+		vector.setX(x);
+		vector.setY(y);
+		vector.setZ(z);
+		return vector; 
+	}
+
+	bool operator==(const Vertex& ver) const {
+		return x == ver.x && y == ver.y && z == ver.z;
+	}
+	double operator*(const Vertex& ver)const {
+		return ver.x * x + ver.y * y + ver.z * z;
+	}
+	Vertex operator+(const Vertex& ver) const {
+		return Vertex(ver.x + x, ver.y + y, ver.z + z);
+	}
+	Vertex operator-(const Vertex& ver) const {
+		return Vertex(ver.x - x, ver.y - y, ver.z - z);
+	}
+	friend QDebug operator<<(QDebug dbg, const Vertex& vertex) {
+		dbg.nospace() << "Vertex(" << vertex.x << ", " << vertex.y << ", " << vertex.z << " )";
+		return dbg.space();
+	}
+};
+
+class Face {
+public:
+	H_edge* edge;
+
+	Face(H_edge* edge) : edge(edge) {}
+};
+
+class H_edge {
+public:
+	Vertex* vert_origin;
+	Face* face;
+	H_edge* edge_prev, * edge_next;
+	H_edge* pair;
+
+	H_edge() {
+		vert_origin = nullptr;
+		face = nullptr;
+		edge_prev = nullptr;
+		edge_next = nullptr;
+		pair = nullptr;
+	}
+	H_edge(Vertex* origin, Face* fc, H_edge* ePrevious, H_edge* eNext, H_edge* pair) : vert_origin(origin), face(fc),
+		edge_prev(ePrevious), edge_next(eNext), pair(pair) {}
+	void setEdge(Vertex* origin, Face* fc, H_edge* ePrevious, H_edge* eNext, H_edge* pair) {
+		vert_origin = origin;
+		face = fc;
+		edge_prev = ePrevious;
+		edge_next = eNext;
+		this->pair = pair;
+	}
+
+	bool operator==(const H_edge& e) const {
+		return e.edge_next == edge_next && e.edge_prev == edge_prev && e.face == face && e.vert_origin == vert_origin && e.pair == pair;
+	}
+	bool operator!=(const H_edge& e) const {
+		return e.edge_next != edge_next || e.edge_prev != edge_prev || e.face != face || e.vert_origin != vert_origin || e.pair != pair;
+	}
+};
+
+//Spatially coherent cluster of faces, faces of cluster are stored in one run of object's faces
+struct Meshlet {
+	int firstFace = 0;
+	int faceCount = 0;
+	//triangles of fans of its faces
+	int triangleCount = 0;
+	//bounding sphere
+	Vertex center;
+	double radius = 0;
+	//normals of all its triangles lie in cone around axis, cutoff is sine of cone's half-angle,
+	//cutoff above 1 turns off back-face culling of cluster (open mesh or too wide cone)
+	QVector3D coneAxis;
+	double coneCutoff = 2;
+};
+
+class Object_H_edge {
+public:
+	QVector<Vertex*> vertices;
+	QVector<H_edge*> edges;
+	QVector<Face*> faces;
+	QHash<Face*, QColor> colors;
+	//Indexed topology built once at load, indices point into vertices
+	//every undirected edge once (half-edge without pair or the one with lower address of twin pair)
+	QVector<QPair<int, int>> unique_edges;
+	//faces split into triangle fans, three indices per triangle
+	QVector<int> triangle_indices;
+	//clusters of 64 - 128 triangles covering all faces in order
+	QVector<Meshlet> meshlets;
+
+	Object_H_edge() {};
+	Object_H_edge(QVector<Vertex*> vert, QVector<H_edge*> edg, QVector<Face*> fcs) : vertices(std::move(vert)), edges(std::move(edg)), faces(std::move(fcs)) {
+		buildMeshlets();
+		buildIndices();
+	};
+
+	//Object doesn't own its elements by itself, whoever loaded it frees them once it's no longer drawn
+	void release() {
+		qDeleteAll(vertices);
+		qDeleteAll(edges);
+		qDeleteAll(faces);
+		vertices.clear();
+		edges.clear();
+		faces.clear();
+		colors.clear();
+		unique_edges.clear();
+		triangle_indices.clear();
+		meshlets.clear();
+	}
+	//Splits faces into clusters and reorders faces, edges and vertices so every cluster is stored together
+	void buildMeshlets();
+	//Stores faces in given order (new position -> old index), edges follow their faces and vertices are renumbered by first use,
+	//half-edge links are pointers so they stay valid, indices have to be rebuilt afterwards
+	void applyFaceOrder(const QVector<int>& faceOrder);
+	void buildIndices() {
+		QHash<const Vertex*, int> vertexIndex;
+		vertexIndex.reserve(vertices.length());
+		for (int i = 0; i < vertices.length(); i++) {
+			vertexIndex.insert(vertices[i], i);
+		}
+		unique_edges.resize(0);
+		for (const H_edge* edge : edges) {
+			if (edge->pair == nullptr || edge < edge->pair) {
+				unique_edges.append({ vertexIndex.value(edge->vert_origin), vertexIndex.value(edge->edge_next->vert_origin) });
+			}
+		}
+		triangle_indices.resize(0);
+		for (const Face* face : faces) {
+			int first = vertexIndex.value(face->edge->vert_origin);
+			for (const H_edge* edge = face->edge->edge_next; edge->edge_next != face->edge; edge = edge->edge_next) {
+				triangle_indices.append(first);
+				triangle_indices.append(vertexIndex.value(edge->vert_origin));
+				triangle_indices.append(vertexIndex.value(edge->edge_next->vert_origin));
+			}
+		}
+	}
+
+	bool operator==(const Object_H_edge& obj) const {
+		return vertices == obj.vertices && edges == obj.edges && faces == obj.faces && colors == obj.colors;
+	}
+	bool operator!=(const Object_H_edge& obj) const {
+		return vertices != obj.vertices || edges != obj.edges || faces != obj.faces || colors != obj.colors;
+	}
+
+};
+
+void createCubeVTK(double d, const QString& filename);
+
+Object_H_edge loadPolygonsVTK(const QString& filename);
+
+//Writes faces and vertices in their current order, ".vtk" is appended to filename
+bool savePolygonsVTK(const QString& filename, const Object_H_edge& object);
+
+void createCubeVTK(const QVector<Vertex>& vertices, const QString& filename);
+
+void rotateCubeAnimation(double d, int frames);
+
+void createUvSphereVTK(double r, int longitude, int latitude, const QString& filename, int mode);
+
+//Stream versions of VTK functions, stream may be file or string in memory
+class QTextStream;
+void writeCubeVTK(QTextStream& out, double d);
+void writeUvSphereVTK(QTextStream& out, double r, int longitude, int latitude, int mode);
+Object_H_edge readPolygonsVTK(QTextStream& input);
+void writePolygonsVTK(QTextStream& output, const Object_H_edge& object);
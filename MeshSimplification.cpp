@@ -0,0 +1,390 @@
+#include "MeshSimplification.h"
+#include "Renderer.h"
+#include <QSet>
+#include <queue>
+#include <cfloat>
+
+//Symmetric 4x4 matrix of summed plane equations, only upper triangle is stored
+struct Quadric {
+	double a[10] = {};
+
+	void addPlane(double nx, double ny, double nz, double d, double weight) {
+		a[0] += weight * nx * nx; a[1] += weight * nx * ny; a[2] += weight * nx * nz; a[3] += weight * nx * d;
+		a[4] += weight * ny * ny; a[5] += weight * ny * nz; a[6] += weight * ny * d;
+		a[7] += weight * nz * nz; a[8] += weight * nz * d;
+		a[9] += weight * d * d;
+	}
+	Quadric operator+(const Quadric& q) const {
+		Quadric sum;
+		for (int i = 0; i < 10; i++) {
+			sum.a[i] = a[i] + q.a[i];
+		}
+		return sum;
+	}
+	//sum of squared distances of point from all planes
+	double error(double x, double y, double z) const {
+		return a[0] * x * x + 2 * a[1] * x * y + 2 * a[2] * x * z + 2 * a[3] * x + a[4] * y * y + 2 * a[5] * y * z + 2 * a[6] * y +
+			a[7] * z * z + 2 * a[8] * z + a[9];
+	}
+	//point with minimal error, false when planes don't meet in single point
+	bool minimum(double& x, double& y, double& z) const {
+		double det = a[0] * (a[4] * a[7] - a[5] * a[5]) - a[1] * (a[1] * a[7] - a[5] * a[2]) + a[2] * (a[1] * a[5] - a[4] * a[2]);
+		double scale = std::max({ abs(a[0]), abs(a[4]), abs(a[7]) });
+		if (abs(det) <= 1e-12 * scale * scale * scale) {
+			return false;
+		}
+		double bx = -a[3], by = -a[6], bz = -a[8];
+		x = (bx * (a[4] * a[7] - a[5] * a[5]) - a[1] * (by * a[7] - a[5] * bz) + a[2] * (by * a[5] - a[4] * bz)) / det;
+		y = (a[0] * (by * a[7] - bz * a[5]) - bx * (a[1] * a[7] - a[5] * a[2]) + a[2] * (a[1] * bz - by * a[2])) / det;
+		z = (a[0] * (a[4] * bz - a[5] * by) - a[1] * (a[1] * bz - by * a[2]) + bx * (a[1] * a[5] - a[4] * a[2])) / det;
+		return true;
+	}
+};
+
+//Edge waiting in queue, it's outdated when one of its vertices changed since it was queued
+struct CollapseCandidate {
+	double cost = 0;
+	int v0 = 0, v1 = 0;
+	int stamp0 = 0, stamp1 = 0;
+	double x = 0, y = 0, z = 0;
+	bool operator<(const CollapseCandidate& candidate) const { return cost > candidate.cost; }
+};
+
+//Mesh state during simplification, vertices removed by collapse stay in arrays and are marked dead
+class EdgeCollapseMesh {
+public:
+	QVector<double> positions;
+	QVector<int> triangles;
+	QVector<bool> triangleAlive;
+	QVector<bool> vertexAlive;
+	QVector<int> vertexStamp;
+	QVector<Quadric> quadrics;
+	QVector<QVector<int>> vertexTriangles;
+	int aliveTriangles = 0;
+	//marks of vertices for neighbourhood queries, mark value changes with every query so array isn't cleared
+	QVector<int> marks;
+	int markValue = 0;
+	QVector<int> neighbours;
+
+	EdgeCollapseMesh(const SimplificationInput& input) : positions(input.positions), triangles(input.triangles) {
+		int vertexCount = positions.length() / 3;
+		int triangleCount = triangles.length() / 3;
+		triangleAlive.fill(true, triangleCount);
+		vertexAlive.fill(true, vertexCount);
+		vertexStamp.fill(0, vertexCount);
+		quadrics.resize(vertexCount);
+		vertexTriangles.resize(vertexCount);
+		marks.fill(0, vertexCount);
+		aliveTriangles = triangleCount;
+		QHash<QPair<int, int>, int> edgeUse;
+		for (int t = 0; t < triangleCount; t++) {
+			double n[3];
+			double area = normal(t, n);
+			const double* p = position(triangles[3 * t]);
+			double d = -(n[0] * p[0] + n[1] * p[1] + n[2] * p[2]);
+			for (int i = 0; i < 3; i++) {
+				int v = triangles[3 * t + i];
+				//planes are weighted by area of triangle, small triangles don't hold big flat regions
+				quadrics[v].addPlane(n[0], n[1], n[2], d, area);
+				vertexTriangles[v].append(t);
+				int w = triangles[3 * t + (i + 1) % 3];
+				edgeUse[{ std::min(v, w), std::max(v, w) }]++;
+			}
+		}
+		//border edges get plane perpendicular to their triangle, so open borders of scans don't shrink
+		for (int t = 0; t < triangleCount; t++) {
+			double n[3];
+			normal(t, n);
+			for (int i = 0; i < 3; i++) {
+				int v = triangles[3 * t + i];
+				int w = triangles[3 * t + (i + 1) % 3];
+				if (edgeUse.value({ std::min(v, w), std::max(v, w) }) != 1) {
+					continue;
+				}
+				const double* p = position(v);
+				const double* q = position(w);
+				double e[3] = { q[0] - p[0], q[1] - p[1], q[2] - p[2] };
+				double b[3] = { e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0] };
+				double length = sqrt(b[0] * b[0] + b[1] * b[1] + b[2] * b[2]);
+				if (length == 0) {
+					continue;
+				}
+				b[0] /= length; b[1] /= length; b[2] /= length;
+				double d = -(b[0] * p[0] + b[1] * p[1] + b[2] * p[2]);
+				double weight = 1000 * (e[0] * e[0] + e[1] * e[1] + e[2] * e[2]);
+				quadrics[v].addPlane(b[0], b[1], b[2], d, weight);
+				quadrics[w].addPlane(b[0], b[1], b[2], d, weight);
+			}
+		}
+	}
+
+	const double* position(int v) const { return positions.constData() + 3 * v; }
+	//unit normal of triangle into n, returns area
+	double normal(int t, double n[3], int replaced = -1, const double* replacement = nullptr) const {
+		const double* p[3];
+		for (int i = 0; i < 3; i++) {
+			int v = triangles[3 * t + i];
+			p[i] = v == replaced ? replacement : position(v);
+		}
+		double u[3] = { p[1][0] - p[0][0], p[1][1] - p[0][1], p[1][2] - p[0][2] };
+		double w[3] = { p[2][0] - p[0][0], p[2][1] - p[0][1], p[2][2] - p[0][2] };
+		n[0] = u[1] * w[2] - u[2] * w[1];
+		n[1] = u[2] * w[0] - u[0] * w[2];
+		n[2] = u[0] * w[1] - u[1] * w[0];
+		double length = sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+		if (length > 0) {
+			n[0] /= length; n[1] /= length; n[2] /= length;
+		}
+		return length / 2;
+	}
+	bool containsVertex(int t, int v) const {
+		return triangles[3 * t] == v || triangles[3 * t + 1] == v || triangles[3 * t + 2] == v;
+	}
+	//vertices sharing alive triangle with v, each of them once
+	const QVector<int>& neighboursOf(int v) {
+		markValue++;
+		neighbours.resize(0);
+		for (int t : vertexTriangles[v]) {
+			if (!triangleAlive[t]) {
+				continue;
+			}
+			for (int i = 0; i < 3; i++) {
+				int w = triangles[3 * t + i];
+				if (w != v && marks[w] != markValue) {
+					marks[w] = markValue;
+					neighbours.append(w);
+				}
+			}
+		}
+		return neighbours;
+	}
+
+	CollapseCandidate candidate(int v0, int v1) const {
+		CollapseCandidate candidate;
+		candidate.v0 = v0;
+		candidate.v1 = v1;
+		candidate.stamp0 = vertexStamp[v0];
+		candidate.stamp1 = vertexStamp[v1];
+		Quadric q = quadrics[v0] + quadrics[v1];
+		if (q.minimum(candidate.x, candidate.y, candidate.z)) {
+			candidate.cost = q.error(candidate.x, candidate.y, candidate.z);
+		}
+		else {
+			//singular quadric (flat or straight region), best of end points and midpoint is taken
+			const double* p = position(v0);
+			const double* r = position(v1);
+			double options[3][3] = { { p[0], p[1], p[2] }, { r[0], r[1], r[2] }, { (p[0] + r[0]) / 2, (p[1] + r[1]) / 2, (p[2] + r[2]) / 2 } };
+			candidate.cost = DBL_MAX;
+			for (const double* option : options) {
+				double cost = q.error(option[0], option[1], option[2]);
+				if (cost < candidate.cost) {
+					candidate.cost = cost;
+					candidate.x = option[0];
+					candidate.y = option[1];
+					candidate.z = option[2];
+				}
+			}
+		}
+		candidate.cost = std::max(candidate.cost, 0.0);
+		return candidate;
+	}
+
+	//Collapse must keep surface manifold and mustn't flip any triangle around edge
+	bool collapseAllowed(const CollapseCandidate& c) {
+		int sharedTriangles = 0;
+		for (int t : vertexTriangles[c.v0]) {
+			if (triangleAlive[t] && containsVertex(t, c.v1)) {
+				sharedTriangles++;
+			}
+		}
+		if (sharedTriangles == 0) {
+			return false;
+		}
+		//link condition, vertices neighbouring both ends are exactly opposite vertices of shared triangles
+		neighboursOf(c.v0);
+		int neighbourMark = markValue;
+		int commonNeighbours = 0;
+		for (int t : vertexTriangles[c.v1]) {
+			if (!triangleAlive[t]) {
+				continue;
+			}
+			for (int i = 0; i < 3; i++) {
+				int w = triangles[3 * t + i];
+				if (w != c.v1 && w != c.v0 && marks[w] == neighbourMark) {
+					//counted once, mark is moved past current query
+					marks[w] = neighbourMark - 1;
+					commonNeighbours++;
+				}
+			}
+		}
+		if (commonNeighbours != sharedTriangles) {
+			return false;
+		}
+		double target[3] = { c.x, c.y, c.z };
+		for (int v : { c.v0, c.v1 }) {
+			for (int t : vertexTriangles[v]) {
+				if (!triangleAlive[t] || (containsVertex(t, c.v0) && containsVertex(t, c.v1))) {
+					continue;
+				}
+				double before[3], after[3];
+				normal(t, before);
+				double area = normal(t, after, v, target);
+				if (area == 0 || before[0] * after[0] + before[1] * after[1] + before[2] * after[2] < 0.2) {
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	//v1 is merged into v0, which moves to position of candidate
+	void collapse(const CollapseCandidate& c) {
+		positions[3 * c.v0] = c.x;
+		positions[3 * c.v0 + 1] = c.y;
+		positions[3 * c.v0 + 2] = c.z;
+		quadrics[c.v0] = quadrics[c.v0] + quadrics[c.v1];
+		for (int t : vertexTriangles[c.v1]) {
+			if (!triangleAlive[t]) {
+				continue;
+			}
+			if (containsVertex(t, c.v0)) {
+				triangleAlive[t] = false;
+				aliveTriangles--;
+				continue;
+			}
+			for (int i = 0; i < 3; i++) {
+				if (triangles[3 * t + i] == c.v1) {
+					triangles[3 * t + i] = c.v0;
+				}
+			}
+			vertexTriangles[c.v0].append(t);
+		}
+		vertexTriangles[c.v1].clear();
+		vertexAlive[c.v1] = false;
+		vertexStamp[c.v0]++;
+		vertexStamp[c.v1]++;
+		QVector<int>& around = vertexTriangles[c.v0];
+		around.erase(std::remove_if(around.begin(), around.end(), [&](int t) { return !triangleAlive[t]; }), around.end());
+	}
+
+	//Alive triangles as new half-edge object, only used vertices are kept
+	Object_H_edge toObject(const QVector<QColor>& colors) const {
+		QVector<int> remap(vertexAlive.length(), -1);
+		QVector<Vertex*> vertices;
+		QVector<H_edge*> edges;
+		QVector<Face*> faces;
+		QHash<Face*, QColor> faceColors;
+		QHash<QPair<int, int>, H_edge*> edgeMap;
+		for (int t = 0; t < triangleAlive.length(); t++) {
+			if (!triangleAlive[t]) {
+				continue;
+			}
+			int index[3];
+			for (int i = 0; i < 3; i++) {
+				int v = triangles[3 * t + i];
+				if (remap[v] < 0) {
+					remap[v] = vertices.length();
+					vertices.append(new Vertex(positions[3 * v], positions[3 * v + 1], positions[3 * v + 2]));
+				}
+				index[i] = remap[v];
+			}
+			H_edge* triangleEdges[3];
+			for (int i = 0; i < 3; i++) {
+				triangleEdges[i] = new H_edge(vertices[index[i]], nullptr, nullptr, nullptr, nullptr);
+			}
+			Face* face = new Face(triangleEdges[0]);
+			for (int i = 0; i < 3; i++) {
+				triangleEdges[i]->edge_next = triangleEdges[(i + 1) % 3];
+				triangleEdges[i]->edge_prev = triangleEdges[(i + 2) % 3];
+				triangleEdges[i]->face = face;
+				int start = index[i];
+				int end = index[(i + 1) % 3];
+				if (edgeMap.contains({ end, start })) {
+					triangleEdges[i]->pair = edgeMap.take({ end, start });
+					triangleEdges[i]->pair->pair = triangleEdges[i];
+				}
+				else {
+					edgeMap.insert({ start, end }, triangleEdges[i]);
+				}
+				edges.append(triangleEdges[i]);
+			}
+			faces.append(face);
+			faceColors.insert(face, colors.value(t));
+		}
+		Object_H_edge object(std::move(vertices), std::move(edges), std::move(faces));
+		object.colors = std::move(faceColors);
+		return object;
+	}
+};
+
+SimplificationInput simplificationInput(const Object_H_edge& object) {
+	SimplificationInput input;
+	input.positions.reserve(3 * object.vertices.length());
+	for (const Vertex* vertex : object.vertices) {
+		input.positions.append(vertex->x);
+		input.positions.append(vertex->y);
+		input.positions.append(vertex->z);
+	}
+	//triangle indices are fans of faces in order of faces, face with n edges gives n - 2 triangles
+	input.triangles = object.triangle_indices;
+	input.triangleColors.reserve(input.triangles.length() / 3);
+	for (Face* face : object.faces) {
+		int edgeCount = 0;
+		const H_edge* edge = face->edge;
+		do {
+			edgeCount++;
+			edge = edge->edge_next;
+		} while (edge != face->edge);
+		QColor color = object.colors.value(face);
+		for (int i = 2; i < edgeCount; i++) {
+			input.triangleColors.append(color);
+		}
+	}
+	return input;
+}
+
+QVector<Object_H_edge> simplifyMesh(const SimplificationInput& input, const QVector<double>& ratios, const std::atomic<bool>* cancel) {
+	QVector<Object_H_edge> levels;
+	EdgeCollapseMesh mesh(input);
+	std::priority_queue<CollapseCandidate> queue;
+	//every undirected edge is queued once
+	QSet<QPair<int, int>> queued;
+	for (int t = 0; t < mesh.triangleAlive.length(); t++) {
+		for (int i = 0; i < 3; i++) {
+			int v = mesh.triangles[3 * t + i];
+			int w = mesh.triangles[3 * t + (i + 1) % 3];
+			QPair<int, int> edge(std::min(v, w), std::max(v, w));
+			if (!queued.contains(edge)) {
+				queued.insert(edge);
+				queue.push(mesh.candidate(edge.first, edge.second));
+			}
+		}
+	}
+	int triangleCount = mesh.aliveTriangles;
+	int collapses = 0;
+	for (double ratio : ratios) {
+		int target = static_cast<int>(triangleCount * ratio);
+		while (mesh.aliveTriangles > target && !queue.empty()) {
+			if (cancel != nullptr && ++collapses % 1024 == 0 && cancel->load()) {
+				for (Object_H_edge& level : levels) {
+					level.release();
+				}
+				return QVector<Object_H_edge>();
+			}
+			CollapseCandidate c = queue.top();
+			queue.pop();
+			if (!mesh.vertexAlive[c.v0] || !mesh.vertexAlive[c.v1] || mesh.vertexStamp[c.v0] != c.stamp0 || mesh.vertexStamp[c.v1] != c.stamp1) {
+				continue;
+			}
+			if (!mesh.collapseAllowed(c)) {
+				continue;
+			}
+			mesh.collapse(c);
+			for (int w : mesh.neighboursOf(c.v0)) {
+				queue.push(mesh.candidate(c.v0, w));
+			}
+		}
+		levels.append(mesh.toObject(input.triangleColors));
+	}
+	return levels;
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include <QVector>
+#include <QColor>
+#include <atomic>
+
+class Object_H_edge;
+
+//Triangles of object copied out of half-edge structure, simplification runs on this copy,
+//so it may run in background while drawing transforms vertices of original object in place
+struct SimplificationInput {
+	//x, y, z of every vertex
+	QVector<double> positions;
+	//three vertex indices per triangle
+	QVector<int> triangles;
+	QVector<QColor> triangleColors;
+};
+
+SimplificationInput simplificationInput(const Object_H_edge& object);
+
+//Quadric error edge collapse, returns one object for every ratio of triangles (ratios go from finest to coarsest),
+//triangles keep colors of faces they come from. Empty vector is returned when cancel is set while running
+QVector<Object_H_edge> simplifyMesh(const SimplificationInput& input, const QVector<double>& ratios, const std::atomic<bool>* cancel = nullptr);
@@ -0,0 +1,214 @@
+#include "Renderer.h"
+#include <cfloat>
+
+//Clusters of faces are kept between these triangle counts, small cluster is only left when its surface is used up
+static const int meshletMaxTriangles = 128;
+static const int meshletMinTriangles = 64;
+
+//Spreads lower 10 bits of value so two zero bits follow every bit, three spread coordinates interleave into Morton code
+static quint32 spreadBits(quint32 value) {
+	value &= 0x3ff;
+	value = (value | (value << 16)) & 0x030000ff;
+	value = (value | (value << 8)) & 0x0300f00f;
+	value = (value | (value << 4)) & 0x030c30c3;
+	value = (value | (value << 2)) & 0x09249249;
+	return value;
+}
+
+static QVector3D triangleNormal(const Vertex& A, const Vertex& B, const Vertex& C) {
+	return QVector3D::crossProduct((B - A).toQVector3D(), (C - A).toQVector3D());
+}
+
+void Object_H_edge::applyFaceOrder(const QVector<int>& faceOrder) {
+	//faces are stored in given order, edges follow their faces and vertices are numbered by first use
+	const int faceCount = faces.length();
+	QVector<Face*> orderedFaces(faceCount);
+	QVector<H_edge*> orderedEdges;
+	orderedEdges.reserve(edges.length());
+	for (int i = 0; i < faceCount; i++) {
+		orderedFaces[i] = faces[faceOrder[i]];
+		H_edge* edge = orderedFaces[i]->edge;
+		do {
+			orderedEdges.append(edge);
+			edge = edge->edge_next;
+		} while (edge != orderedFaces[i]->edge);
+	}
+	QHash<const Vertex*, int> vertexIndex;
+	vertexIndex.reserve(vertices.length());
+	for (int i = 0; i < vertices.length(); i++) {
+		vertexIndex.insert(vertices[i], i);
+	}
+	QVector<bool> vertexUsed(vertices.length(), false);
+	QVector<Vertex*> orderedVertices;
+	orderedVertices.reserve(vertices.length());
+	for (const H_edge* edge : orderedEdges) {
+		int index = vertexIndex.value(edge->vert_origin, -1);
+		if (index >= 0 && !vertexUsed[index]) {
+			vertexUsed[index] = true;
+			orderedVertices.append(vertices[index]);
+		}
+	}
+	for (int i = 0; i < vertices.length(); i++) {
+		if (!vertexUsed[i]) {
+			orderedVertices.append(vertices[i]);
+		}
+	}
+	faces = std::move(orderedFaces);
+	//edges not reachable from faces would be lost, order of such object is kept
+	if (orderedEdges.length() == edges.length()) {
+		edges = std::move(orderedEdges);
+	}
+	vertices = std::move(orderedVertices);
+}
+
+void Object_H_edge::buildMeshlets() {
+	meshlets.clear();
+	const int faceCount = faces.length();
+	if (faceCount == 0) {
+		return;
+	}
+	QHash<const Face*, int> faceIndex;
+	faceIndex.reserve(faceCount);
+	for (int i = 0; i < faceCount; i++) {
+		faceIndex.insert(faces[i], i);
+	}
+	//centroids and triangle counts of faces, orientation of closed mesh is taken from sign of its volume
+	QVector<Vertex> centroids(faceCount);
+	QVector<int> faceTriangles(faceCount);
+	bool closed = true;
+	double volume = 0;
+	Vertex minimum(DBL_MAX, DBL_MAX, DBL_MAX);
+	Vertex maximum(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	for (int i = 0; i < faceCount; i++) {
+		const H_edge* first = faces[i]->edge;
+		const H_edge* edge = first;
+		Vertex sum;
+		int edgeCount = 0;
+		do {
+			sum = sum + *edge->vert_origin;
+			edgeCount++;
+			if (edge->pair == nullptr) {
+				closed = false;
+			}
+			if (edgeCount >= 3) {
+				const Vertex& A = *first->vert_origin;
+				const Vertex& B = *edge->edge_prev->vert_origin;
+				const Vertex& C = *edge->vert_origin;
+				volume += A.x * (B.y * C.z - B.z * C.y) - A.y * (B.x * C.z - B.z * C.x) + A.z * (B.x * C.y - B.y * C.x);
+			}
+			edge = edge->edge_next;
+		} while (edge != first);
+		centroids[i] = Vertex(sum.x / edgeCount, sum.y / edgeCount, sum.z / edgeCount);
+		faceTriangles[i] = std::max(edgeCount - 2, 1);
+		minimum = Vertex(std::min(minimum.x, centroids[i].x), std::min(minimum.y, centroids[i].y), std::min(minimum.z, centroids[i].z));
+		maximum = Vertex(std::max(maximum.x, centroids[i].x), std::max(maximum.y, centroids[i].y), std::max(maximum.z, centroids[i].z));
+	}
+	const float orientation = volume < 0 ? -1 : 1;
+
+	//seeds of clusters are taken in Morton order of centroids, so next cluster starts close to previous one
+	double scale = 1023 / std::max({ maximum.x - minimum.x, maximum.y - minimum.y, maximum.z - minimum.z, 1e-12 });
+	QVector<QPair<quint32, int>> mortonOrder(faceCount);
+	for (int i = 0; i < faceCount; i++) {
+		Vertex position(centroids[i].x - minimum.x, centroids[i].y - minimum.y, centroids[i].z - minimum.z);
+		mortonOrder[i] = { spreadBits(static_cast<quint32>(position.x * scale)) | spreadBits(static_cast<quint32>(position.y * scale)) << 1 |
+			spreadBits(static_cast<quint32>(position.z * scale)) << 2, i };
+	}
+	std::sort(mortonOrder.begin(), mortonOrder.end());
+
+	//cluster grows from its seed over shared edges (breadth first), faces are assigned when taken from queue
+	QVector<bool> assigned(faceCount, false);
+	QVector<int> faceOrder;
+	faceOrder.reserve(faceCount);
+	QVector<int> queue;
+	int seedPosition = 0;
+	while (faceOrder.length() < faceCount) {
+		Meshlet meshlet;
+		meshlet.firstFace = faceOrder.length();
+		int triangles = 0;
+		queue.resize(0);
+		int queueHead = 0;
+		while (triangles < meshletMaxTriangles) {
+			if (queueHead == queue.length()) {
+				//region around seed is used up, small cluster continues from next free seed
+				if (triangles >= meshletMinTriangles) {
+					break;
+				}
+				while (seedPosition < faceCount && assigned[mortonOrder[seedPosition].second]) {
+					seedPosition++;
+				}
+				if (seedPosition == faceCount) {
+					break;
+				}
+				queue.append(mortonOrder[seedPosition].second);
+			}
+			int face = queue[queueHead++];
+			if (assigned[face]) {
+				continue;
+			}
+			if (triangles > 0 && triangles + faceTriangles[face] > meshletMaxTriangles) {
+				break;
+			}
+			assigned[face] = true;
+			faceOrder.append(face);
+			triangles += faceTriangles[face];
+			const H_edge* edge = faces[face]->edge;
+			do {
+				if (edge->pair != nullptr) {
+					int neighbour = faceIndex.value(edge->pair->face, -1);
+					if (neighbour >= 0 && !assigned[neighbour]) {
+						queue.append(neighbour);
+					}
+				}
+				edge = edge->edge_next;
+			} while (edge != faces[face]->edge);
+		}
+		meshlet.faceCount = faceOrder.length() - meshlet.firstFace;
+		meshlet.triangleCount = triangles;
+		meshlets.append(meshlet);
+	}
+
+	applyFaceOrder(faceOrder);
+
+	//bounds and normal cone of every cluster
+	for (Meshlet& meshlet : meshlets) {
+		Vertex low(DBL_MAX, DBL_MAX, DBL_MAX);
+		Vertex high(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+		QVector3D axis;
+		for (int i = meshlet.firstFace; i < meshlet.firstFace + meshlet.faceCount; i++) {
+			const H_edge* first = faces[i]->edge;
+			const H_edge* edge = first;
+			int edgeCount = 0;
+			do {
+				const Vertex& vertex = *edge->vert_origin;
+				low = Vertex(std::min(low.x, vertex.x), std::min(low.y, vertex.y), std::min(low.z, vertex.z));
+				high = Vertex(std::max(high.x, vertex.x), std::max(high.y, vertex.y), std::max(high.z, vertex.z));
+				if (++edgeCount >= 3) {
+					axis += orientation * triangleNormal(*first->vert_origin, *edge->edge_prev->vert_origin, vertex);
+				}
+				edge = edge->edge_next;
+			} while (edge != first);
+		}
+		meshlet.center = Vertex((low.x + high.x) / 2, (low.y + high.y) / 2, (low.z + high.z) / 2);
+		Vertex halfDiagonal = high - meshlet.center;
+		meshlet.radius = sqrt(halfDiagonal * halfDiagonal);
+		meshlet.coneCutoff = 2;
+		//faces of open mesh may be seen from both sides, their clusters are never culled as back-facing
+		if (!closed || axis.length() <= 0) {
+			continue;
+		}
+		meshlet.coneAxis = axis.normalized();
+		double minimalDot = 1;
+		for (int i = meshlet.firstFace; i < meshlet.firstFace + meshlet.faceCount; i++) {
+			const H_edge* first = faces[i]->edge;
+			for (const H_edge* edge = first->edge_next->edge_next; edge != first; edge = edge->edge_next) {
+				QVector3D normal = orientation * triangleNormal(*first->vert_origin, *edge->edge_prev->vert_origin, *edge->vert_origin);
+				if (normal.length() > 0) {
+					minimalDot = std::min(minimalDot, static_cast<double>(QVector3D::dotProduct(normal.normalized(), meshlet.coneAxis)));
+				}
+			}
+		}
+		if (minimalDot > 0) {
+			meshlet.coneCutoff = sqrt(1 - minimalDot * minimalDot);
+		}
+	}
+}
@@ -75,6 +75,14 @@ void ModelViewer::ViewerWidgetMouseButtonPress(ViewerWidget* w, QEvent* event)
 {
 	QMouseEvent* e = static_cast<QMouseEvent*>(event);
 	qDebug() << e->pos().x() << e->pos().y();
+	//Move scene object, 2D tools are hidden in 3D mode
+	if (isIn3dMode && vW->getDrawObjectActivated() && !vW->getScene().isEmpty()) {
+		if (e->button() == Qt::LeftButton) {
+			draggedSceneObject = w->pickSceneObject(e->pos(), ui->comboBoxProjectionType->currentIndex());
+			w->setDragStartingPosition(e->pos());
+		}
+		return;
+	}
 	//Draw Line
 	if (e->button() == Qt::LeftButton && ui->toolButtonDrawLine->isChecked() && ui->toolButtonDrawLine->isEnabled())
 	{
@@ -111,18 +119,25 @@ void ModelViewer::ViewerWidgetMouseButtonPress(ViewerWidget* w, QEvent* event)
 	else if (e->button() == Qt::LeftButton && ui->toolButtonDrawCircle->isChecked() && ui->toolButtonDrawCircle->isEnabled()) {
 		if (w->getDrawLineActivated()) {
 			w->setDrawLineEnd(e->pos());
+			//with Shift held second point is corner of box around ellipse, ellipse is filled by chosen filling algorithm
+			QString object_type = e->modifiers() & Qt::ShiftModifier ? "ellipse" : "circle";
 			int circle_index = 0;
 			QString object_name = "";
 			while (true) {
-				if (object_map.contains("circle (" + QString::number(circle_index) + ")")) {
+				if (object_map.contains(object_type + " (" + QString::number(circle_index) + ")")) {
 					circle_index++;
 				}
 				else {
-					object_name = "circle (" + QString::number(circle_index) + ")";
+					object_name = object_type + " (" + QString::number(circle_index) + ")";
 					break;
 				}
 			}
-			current_object = Object2D("circle", object_name, { w->getDrawLineBegin(),w->getDrawLineEnd() }, globalColor, object_map.size());
+			if (object_type == "ellipse") {
+				current_object = Object2D(object_type, object_name, { w->getDrawLineBegin(),w->getDrawLineEnd() }, globalColor, globalColor, ui->comboBoxFillingAlg->currentIndex(), object_map.size());
+			}
+			else {
+				current_object = Object2D(object_type, object_name, { w->getDrawLineBegin(),w->getDrawLineEnd() }, globalColor, object_map.size());
+			}
 			object_map.insert(current_object.name, current_object);
 			w->drawObjects2D(object_map);
 			w->setDrawLineActivated(false);
@@ -234,13 +249,21 @@ void ModelViewer::ViewerWidgetMouseButtonRelease(ViewerWidget* w, QEvent* event)
 {
 	w->setDragReady(false);
 	w->setDragStartingPosition(QPoint());
+	draggedSceneObject = -1;
 }
 void ModelViewer::ViewerWidgetMouseMove(ViewerWidget* w, QEvent* event)
 {
 	QMouseEvent* e = static_cast<QMouseEvent*>(event);
+	if (isIn3dMode && draggedSceneObject >= 0) {
+		w->moveSceneObject(draggedSceneObject, e->pos() - w->getDragStartingPosition(), ui->comboBoxProjectionType->currentIndex());
+		w->setDragStartingPosition(e->pos());
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		return;
+	}
 	if (ui->toolButtonEditPosition->isChecked() && w->getDragReady()) {
 		QPoint delta = w->getDragStartingPosition() - e->pos();
-		if (current_object.type == "line" || current_object.type == "circle") {
+		if (current_object.type == "line" || current_object.type == "circle" || current_object.type == "ellipse") {
 			current_object.points = { current_object.points[0] - delta, current_object.points[1] - delta };
 			object_map[current_object.name] = current_object;
 		}
@@ -253,21 +276,24 @@ void ModelViewer::ViewerWidgetMouseMove(ViewerWidget* w, QEvent* event)
 			object_map[current_object.name] = current_object;
 		}
 		else if (current_object.type == "curve") {
-			QVector<QPair<QPoint, QPoint>> pointTmp = current_object.curve_points;
-			for (QPair<QPoint, QPoint>& pair :pointTmp) {
+			//editing object stored in map, so its cached segments survive and only affected ones are invalidated
+			Object2D& object = object_map[current_object.name];
+			for (int i = 0; i < object.curve_points.length(); i++) {
+				QPair<QPoint, QPoint>& pair = object.curve_points[i];
 				if (w->getDragedPoint() == pair.first) {
 					pair.first -= delta;
 					w->setDragedPoint(pair.first);
+					object.invalidateCurveSegments(i);
 					break;
 				}
 				else if (w->getDragedPoint() == pair.second) {
 					pair.second -= delta;
 					w->setDragedPoint(pair.second);
+					object.invalidateCurveSegments(i);
 					break;
 				}
 			}
-			current_object.curve_points = pointTmp;
-			object_map[current_object.name] = current_object;
+			current_object = object;
 		}
 		w->setDragStartingPosition(e->pos());
 		vW->clear();
@@ -548,132 +574,14 @@ void ModelViewer::loadSceneState(QString filename) {
 		return;
 	}
 	QMap<QString, Object2D> object_map_temporary = QMap<QString, Object2D>();
-	bool correct_format = true;
+	QSize scene_size;
 	QTextStream in(&file);
-	if (in.readLine().trimmed() != "MODELVIEWER 2D SCENE FORMAT") {
-		correct_format = false;
-	}
-	QString file_line = in.readLine();
-	QList<QString> file_data = file_line.split(":");
-	if (file_data.length() != 3 || file_data[0] != "SIZE") {
-		correct_format = false;
-	}
-	else {
-		sizex = file_data[1].toInt(&correct_format);
-		sizey = file_data[2].toInt(&correct_format);
-	}
-	while (!in.atEnd() && correct_format == true) {
-		//TYPE
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 2 || file_data[0] != "TYPE") {
-			correct_format = false;
-		}
-		QString object_type = file_data[1].trimmed().toLower();
-		//NAME
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 2 || file_data[0] != "NAME") {
-			correct_format = false;
-		}
-		QString object_name = file_data[1].trimmed();
-		//OUTLINE_COLOR
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 4 || file_data[0] != "OUTLINE_COLOR") {
-			correct_format = false;
-		}
-		correct_format = !std::all_of(file_data.begin() + 1, file_data.end(), [](QString string) {
-			bool ok;
-			string.toInt(&ok);
-			return ok;
-			});
-		QColor object_outline_color = QColor(file_data[1].toInt(), file_data[2].toInt(), file_data[3].toInt());
-		//FILLING_COLOR
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 4 || file_data[0] != "FILLING_COLOR") {
-			correct_format = false;
-		}
-		correct_format = !std::all_of(file_data.begin() + 1, file_data.end(), [](QString string) {
-			bool ok;
-			string.toInt(&ok);
-			return ok;
-			});
-		QColor object_filling_color = QColor(file_data[1].toInt(), file_data[2].toInt(), file_data[3].toInt());
-		//FILLING_ALG
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 2 || file_data[0] != "FILLING_ALG") {
-			correct_format = false;
-		}
-		int object_filling_alg = file_data[1].toInt(&correct_format);
-		//CURVE_TYPE
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 2 || file_data[0] != "CURVE_TYPE") {
-			correct_format = false;
-		}
-		int object_curve_type = file_data[1].toInt(&correct_format);
-		//LAYER
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 2 || file_data[0] != "LAYER") {
-			correct_format = false;
-		}
-		int object_layer = file_data[1].toInt(&correct_format);
-		//POINTS
-		file_line = in.readLine();
-		file_data = file_line.split(":");
-		if (file_data.length() != 2 || file_data[0] != "POINTS") {
-			correct_format = false;
-		}
-		int object_points_count = file_data[1].toInt(&correct_format);
-		if ((object_type == "line" || object_type == "circle") && object_points_count != 2) {
-			correct_format = false;
-		}
-		QVector<QPair<QPoint, QPoint>> object_curve_points = QVector<QPair<QPoint, QPoint>>();
-		QVector<QPoint> object_points = QVector<QPoint>();
-		for (int i = 0; i < object_points_count; i++) {
-			file_data = in.readLine().split(":");
-			if (object_type == "curve" && file_data.length() == 4) {
-				QPoint start(file_data[0].toInt(&correct_format), file_data[1].toInt(&correct_format));
-				if (!file_data[2].isEmpty() && !file_data[3].isEmpty()) {
-					QPoint end(file_data[2].toInt(&correct_format), file_data[3].toInt(&correct_format));
-					object_curve_points.append({ start,end });
-				}
-				else {
-					object_curve_points.append({ start,QPoint() });
-				}
-			}
-			else if (file_data.length() == 2) {
-				QPoint point(file_data[0].toInt(&correct_format), file_data[1].toInt(&correct_format));
-				object_points.append(point);
-			}
-		}
-		file_line = in.readLine();
-		if (!file_line.trimmed().isEmpty()) {
-			correct_format = false;
-			break;
-		}
-		Object2D object = Object2D();
-		object.type = object_type;
-		object.name = object_name;
-		object.color_outline = object_outline_color;
-		object.color_filling = object_filling_color;
-		object.filling_alg = object_filling_alg;
-		object.curve_type = object_curve_type;
-		object.layer_height = object_layer;
-		object.curve_points = object_curve_points;
-		object.points = object_points;
-
-		object_map_temporary.insert(object.name, object);
-
-	}
-	if (!correct_format) {
+	if (!readSceneState(in, scene_size, object_map_temporary)) {
 		QMessageBox::warning(nullptr, "Warning", "Wrong format file!", QMessageBox::Ok);
 	}
 	else {
+		sizex = scene_size.width();
+		sizey = scene_size.height();
 		createViewerWidget(sizex, sizey);
 
 		vW->setObjectName("ViewerWidget");
@@ -1044,10 +952,10 @@ void ModelViewer::on_actionOpen_triggered()
 			msgBox.exec();
 		}
 		else {
-			vW->setCurrentObject(object);
+			vW->setCurrentObject(std::move(object));
 			on_action3D_triggered();
 			vW->setDrawObjectActivated(true);
-			vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), nullptr);
+			vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), nullptr);
 		}
 	}
 	else if (!openImage(fileName)) {
@@ -1077,6 +985,91 @@ void ModelViewer::on_actionSave_as_triggered()
 		msgBox.exec();
 	}
 }
+void ModelViewer::on_actionSave_object_triggered()
+{
+	if (!vW->getDrawObjectActivated()) {
+		msgBox.setText("No object is loaded.");
+		msgBox.setIcon(QMessageBox::Warning);
+		msgBox.exec();
+		return;
+	}
+	QString folder = settings.value("folder_img_save_path", "").toString();
+	QString fileName = QFileDialog::getSaveFileName(this, "Save object", folder, "VTK data (*.vtk)");
+	if (fileName.isEmpty()) {
+		return;
+	}
+	//extension is added when writing
+	if (fileName.endsWith(".vtk")) {
+		fileName.chop(4);
+	}
+	if (!savePolygonsVTK(fileName, vW->getCurrentObject())) {
+		msgBox.setText("Unable to save object.");
+		msgBox.setIcon(QMessageBox::Warning);
+	}
+	else {
+		msgBox.setText(QString("File %1.vtk saved.").arg(fileName));
+		msgBox.setIcon(QMessageBox::Information);
+	}
+	msgBox.exec();
+}
+void ModelViewer::on_actionLoad_instances_triggered()
+{
+	QString filename = QFileDialog::getOpenFileName(this, "Load instances", QDir::currentPath(), "Text files(*.txt)");
+	if (filename.isEmpty()) {
+		return;
+	}
+	QFile file(filename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		msgBox.setText("Unable to open instances.");
+		msgBox.setIcon(QMessageBox::Warning);
+		msgBox.exec();
+		return;
+	}
+	QTextStream in(&file);
+	QVector<ObjectInstance> instances;
+	if (!readInstances(in, instances)) {
+		QMessageBox::warning(nullptr, "Warning", "Wrong format file!", QMessageBox::Ok);
+		return;
+	}
+	vW->setInstances(std::move(instances));
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionClear_instances_triggered()
+{
+	vW->setInstances(QVector<ObjectInstance>());
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionLoad_assembly_triggered()
+{
+	QString filename = QFileDialog::getOpenFileName(this, "Load assembly", QDir::currentPath(), "Text files(*.txt)");
+	if (filename.isEmpty()) {
+		return;
+	}
+	QFile file(filename);
+	if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		msgBox.setText("Unable to open assembly.");
+		msgBox.setIcon(QMessageBox::Warning);
+		msgBox.exec();
+		return;
+	}
+	QTextStream in(&file);
+	//scene is drawn in place of current object
+	vW->setCurrentObject(Object_H_edge());
+	vW->setInstances(QVector<ObjectInstance>());
+	if (!readAssembly(in, QFileInfo(filename).absolutePath(), vW->getScene())) {
+		QMessageBox::warning(nullptr, "Warning", "Wrong format file!", QMessageBox::Ok);
+		return;
+	}
+	on_action3D_triggered();
+	vW->setDrawObjectActivated(true);
+	vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), nullptr);
+}
 void ModelViewer::on_actionClear_triggered()
 {
 	ui->toolButtonDrawCircle->setEnabled(true);
@@ -1105,6 +1098,101 @@ void ModelViewer::on_actionClear_triggered()
 	current_object = Object2D();
 	objectTableWidgetUpdate();
 }
+void ModelViewer::on_actionAntialiasing_toggled(bool checked)
+{
+	vW->setAntialiasing(checked);
+	vW->clear();
+	if (isIn3dMode) {
+		if (vW->getDrawObjectActivated()) {
+			vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		}
+	}
+	else {
+		vW->drawObjects2D(object_map);
+	}
+}
+void ModelViewer::on_actionHiddenLineRemoval_toggled(bool checked)
+{
+	vW->setHiddenLineRemoval(checked);
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionProfilerOverlay_toggled(bool checked)
+{
+	vW->setProfilerOverlay(checked);
+	if (checked && isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionLevelOfDetail_toggled(bool checked)
+{
+	vW->setLevelOfDetail(checked);
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionBackFaceCulling_toggled(bool checked)
+{
+	vW->setBackFaceCulling(checked);
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionOcclusionCulling_toggled(bool checked)
+{
+	vW->setOcclusionCulling(checked);
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionFrontToBack_toggled(bool checked)
+{
+	vW->setFrontToBack(checked);
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionDepthPrepass_toggled(bool checked)
+{
+	vW->setDepthPrepass(checked);
+	if (isIn3dMode && vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+void ModelViewer::on_actionOptimizeVertexOrder_triggered()
+{
+	if (!isIn3dMode || !vW->getDrawObjectActivated()) {
+		return;
+	}
+	VertexCacheReport report = vW->optimizeCurrentObject();
+	msgBox.setText(QString("Average cache miss ratio %1 -> %2 (%3 % fewer vertex transforms).")
+		.arg(report.acmrBefore, 0, 'f', 3).arg(report.acmrAfter, 0, 'f', 3)
+		.arg(report.acmrBefore > 0 ? 100 * (1 - report.acmrAfter / report.acmrBefore) : 0, 0, 'f', 1));
+	msgBox.setIcon(QMessageBox::Information);
+	msgBox.exec();
+	vW->clear();
+	vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+}
+void ModelViewer::on_actionExportProfilerTrace_triggered()
+{
+	QString filename = QFileDialog::getSaveFileName(this, "Export profiler trace", QDir::currentPath(), "Trace files (*.json)");
+	if (filename.isEmpty()) {
+		return;
+	}
+	if (!vW->getProfiler().writeChromeTrace(filename)) {
+		msgBox.setText("Unable to save profiler trace.");
+		msgBox.setIcon(QMessageBox::Warning);
+		msgBox.exec();
+	}
+}
 void ModelViewer::on_actionExit_triggered()
 {
 	this->close();
@@ -1191,7 +1279,7 @@ void ModelViewer::on_checkBoxLightSettings_stateChanged(int state) {
 	}
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_checkBoxCameraSettings_stateChanged(int state) {
@@ -1244,7 +1332,7 @@ void ModelViewer::on_horizontalSliderZenit_valueChanged(int value) {
 	vW->getProjectionPlane().setProjectionPlane(vW->getProjectionPlane().azimut, radValue);
 	vW->clear();
 	if (vW->getDrawObjectActivated()) {
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_horizontalSliderAzimut_valueChanged(int value) {
@@ -1252,11 +1340,38 @@ void ModelViewer::on_horizontalSliderAzimut_valueChanged(int value) {
 	vW->getProjectionPlane().setProjectionPlane(radValue, vW->getProjectionPlane().zenit);
 	vW->clear();
 	if (vW->getDrawObjectActivated()) {
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 
 }
 
+void ModelViewer::on_horizontalSliderZenit_sliderPressed() {
+	vW->setInteractive(true);
+}
+void ModelViewer::on_horizontalSliderZenit_sliderReleased() {
+	viewInteractionFinished();
+}
+void ModelViewer::on_horizontalSliderAzimut_sliderPressed() {
+	vW->setInteractive(true);
+}
+void ModelViewer::on_horizontalSliderAzimut_sliderReleased() {
+	viewInteractionFinished();
+}
+void ModelViewer::on_horizontalSliderCameraCoordZ_sliderPressed() {
+	vW->setInteractive(true);
+}
+void ModelViewer::on_horizontalSliderCameraCoordZ_sliderReleased() {
+	viewInteractionFinished();
+}
+//last view of interaction is drawn again in level matching its size
+void ModelViewer::viewInteractionFinished() {
+	vW->setInteractive(false);
+	if (vW->getDrawObjectActivated()) {
+		vW->clear();
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+	}
+}
+
 void ModelViewer::on_comboBoxProjectionType_currentIndexChanged(int index) {
 	if (index == 1) {
 		ui->horizontalSliderCameraCoordZ->setEnabled(true);
@@ -1267,14 +1382,14 @@ void ModelViewer::on_comboBoxProjectionType_currentIndexChanged(int index) {
 	if (vW->getDrawObjectActivated()) {
 		vW->getCamera().position.z = ui->horizontalSliderCameraCoordZ->value();
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_horizontalSliderCameraCoordZ_valueChanged(int value) {
 	vW->getCamera().position.z = value;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 
@@ -1282,13 +1397,13 @@ void ModelViewer::on_horizontalSliderCameraCoordZ_valueChanged(int value) {
 void ModelViewer::on_comboBoxRepresentationType_currentIndexChanged(int index) {
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_comboBoxShadingAlg_currentIndexChanged(int index) {
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(),ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(),ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 
@@ -1297,7 +1412,7 @@ void ModelViewer::on_horizontalSliderRdCoefficient_valueChanged(int value) {
 	globalLightSettings->rd = value / 100.;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 	qDebug() << "rd coef : " << globalLightSettings->rd;
 }
@@ -1306,7 +1421,7 @@ void ModelViewer::on_horizontalSliderRsCoefficient_valueChanged(int value) {
 	globalLightSettings->rs = value / 100.;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 	qDebug() << "rs coef : " << globalLightSettings->rs;
 }
@@ -1315,7 +1430,7 @@ void ModelViewer::on_horizontalSliderRaCoefficient_valueChanged(int value) {
 	globalLightSettings->ra = value / 100.;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 	qDebug() << "ra coef : " << globalLightSettings->ra;
 }
@@ -1323,7 +1438,7 @@ void ModelViewer::on_horizontalSliderLightH_valueChanged(int value) {
 	globalLightSettings->h = value;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 	qDebug() << "H : " << globalLightSettings->h;
 }
@@ -1332,21 +1447,21 @@ void ModelViewer::on_spinBoxLightPosX_valueChanged(int value){
 	globalLightSettings->lightPosition.x = value;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_spinBoxLightPosY_valueChanged(int value) {
 	globalLightSettings->lightPosition.y = value;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_spinBoxLightPosZ_valueChanged(int value) {
 	globalLightSettings->lightPosition.z = value;
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 
@@ -1355,21 +1470,21 @@ void ModelViewer::on_spinBoxLightIntensityRed_valueChanged(int value) {
 	globalLightSettings->lightIntesity = QColor(ui->spinBoxLightIntensityRed->value(), ui->spinBoxLightIntensityGreen->value(), ui->spinBoxLightIntensityBlue->value());
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_spinBoxLightIntensityGreen_valueChanged(int value) {
 	globalLightSettings->lightIntesity = QColor(ui->spinBoxLightIntensityRed->value(), ui->spinBoxLightIntensityGreen->value(), ui->spinBoxLightIntensityBlue->value());
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_spinBoxLightIntensityBlue_valueChanged(int value) {
 	globalLightSettings->lightIntesity = QColor(ui->spinBoxLightIntensityRed->value(), ui->spinBoxLightIntensityGreen->value(), ui->spinBoxLightIntensityBlue->value());
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 
@@ -1377,20 +1492,20 @@ void ModelViewer::on_spinBoxLightIntensityAmbientRed_valueChanged(int value) {
 	globalLightSettings->lightIntesityAmbient = QColor(ui->spinBoxLightIntensityAmbientRed->value(), ui->spinBoxLightIntensityAmbientGreen->value(), ui->spinBoxLightIntensityAmbientBlue->value());
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_spinBoxLightIntensityAmbientGreen_valueChanged(int value) {
 	globalLightSettings->lightIntesityAmbient = QColor(ui->spinBoxLightIntensityAmbientRed->value(), ui->spinBoxLightIntensityAmbientGreen->value(), ui->spinBoxLightIntensityAmbientBlue->value());
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
 void ModelViewer::on_spinBoxLightIntensityAmbientBlue_valueChanged(int value) {
 	globalLightSettings->lightIntesityAmbient = QColor(ui->spinBoxLightIntensityAmbientRed->value(), ui->spinBoxLightIntensityAmbientGreen->value(), ui->spinBoxLightIntensityAmbientBlue->value());
 	if (vW->getDrawObjectActivated()) {
 		vW->clear();
-		vW->drawObject(vW->getCurrentObject(), vW->getCamera(), vW->getProjectionPlane(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
+		vW->drawObject(vW->getCurrentObject(), ui->comboBoxProjectionType->currentIndex(), ui->comboBoxRepresentationType->currentIndex(), ui->comboBoxShadingAlg->currentIndex(), globalLightSettings);
 	}
 }
\ No newline at end of file
@@ -34,6 +34,8 @@ private:
 	int colored_row_index = 0;
 
 	bool isIn3dMode = false;
+	//object of 3D scene moved by dragging, -1 when none is dragged
+	int draggedSceneObject = -1;
 
 	//Event filters
 	bool eventFilter(QObject* obj, QEvent* event);
@@ -71,7 +73,21 @@ private slots:
 	//actions
 	void on_actionOpen_triggered();
 	void on_actionSave_as_triggered();
+	void on_actionSave_object_triggered();
+	void on_actionLoad_instances_triggered();
+	void on_actionClear_instances_triggered();
+	void on_actionLoad_assembly_triggered();
 	void on_actionClear_triggered();
+	void on_actionAntialiasing_toggled(bool checked);
+	void on_actionHiddenLineRemoval_toggled(bool checked);
+	void on_actionProfilerOverlay_toggled(bool checked);
+	void on_actionLevelOfDetail_toggled(bool checked);
+	void on_actionBackFaceCulling_toggled(bool checked);
+	void on_actionOcclusionCulling_toggled(bool checked);
+	void on_actionFrontToBack_toggled(bool checked);
+	void on_actionDepthPrepass_toggled(bool checked);
+	void on_actionOptimizeVertexOrder_triggered();
+	void on_actionExportProfilerTrace_triggered();
 	void on_actionExit_triggered();
 	void on_actionSave_state_triggered();
 	void on_actionLoad_state_triggered();
@@ -115,6 +131,14 @@ private slots:
 	void on_horizontalSliderAzimut_valueChanged(int value);
 	void on_comboBoxProjectionType_currentIndexChanged(int index);
 	void on_horizontalSliderCameraCoordZ_valueChanged(int value);
+	//coarse level of detail is drawn while view slider is dragged
+	void on_horizontalSliderZenit_sliderPressed();
+	void on_horizontalSliderZenit_sliderReleased();
+	void on_horizontalSliderAzimut_sliderPressed();
+	void on_horizontalSliderAzimut_sliderReleased();
+	void on_horizontalSliderCameraCoordZ_sliderPressed();
+	void on_horizontalSliderCameraCoordZ_sliderReleased();
+	void viewInteractionFinished();
 	void on_comboBoxRepresentationType_currentIndexChanged(int index);
 	//Light settings
 	void on_comboBoxShadingAlg_currentIndexChanged(int index);
@@ -0,0 +1,139 @@
+#pragma once
+#include <QtGlobal>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+//Number of threads used for parallel drawing, at least one
+inline int parallelThreadCount() {
+	unsigned int count = std::thread::hardware_concurrency();
+	return count == 0 ? 1 : static_cast<int>(count);
+}
+
+//Persistent worker threads of parallel drawing, owned by Renderer. Workers are started on first parallel job and sleep on condition variable
+//between jobs, so frame split into many parallel steps doesn't create threads and dispatching a job doesn't allocate.
+class WorkerPool {
+private:
+	std::vector<std::thread> threads;
+	std::mutex mutex;
+	std::condition_variable jobReady;
+	std::condition_variable jobDone;
+	//current job, its chunks are taken from shared counter by workers and by calling thread
+	void (*runChunk)(void* job, int chunk) = nullptr;
+	void* job = nullptr;
+	int jobChunks = 0;
+	std::atomic<int> nextChunk{ 0 };
+	//workers which haven't finished current job yet, next job is dispatched after all of them
+	int activeWorkers = 0;
+	quint64 generation = 0;
+	bool stopping = false;
+	//set while job runs, parallelFor called from inside of chunk (or from another thread) runs its chunks on calling thread
+	std::atomic<bool> busy{ false };
+	//threads of job including calling thread, 0 takes all cores
+	int threadLimit = 0;
+
+	template <typename Chunk>
+	static void invokeChunk(void* job, int chunk) {
+		(*static_cast<Chunk*>(job))(chunk);
+	}
+	void runChunks() {
+		for (int chunk = nextChunk++; chunk < jobChunks; chunk = nextChunk++) {
+			runChunk(job, chunk);
+		}
+	}
+	//finished is generation of last job before worker started
+	void workerLoop(quint64 finished) {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			jobReady.wait(lock, [this, finished] { return stopping || generation != finished; });
+			if (stopping) {
+				return;
+			}
+			finished = generation;
+			lock.unlock();
+			runChunks();
+			lock.lock();
+			if (--activeWorkers == 0) {
+				jobDone.notify_one();
+			}
+		}
+	}
+	void stopWorkers() {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		jobReady.notify_all();
+		for (std::thread& thread : threads) {
+			thread.join();
+		}
+		threads.clear();
+		stopping = false;
+	}
+	void run(int chunkCount, void* chunkJob, void (*chunkFunction)(void*, int)) {
+		std::unique_lock<std::mutex> lock(mutex);
+		if (threads.empty()) {
+			int workerCount = threadCount() - 1;
+			threads.reserve(workerCount);
+			for (int i = 0; i < workerCount; i++) {
+				threads.emplace_back([this, started = generation]() { workerLoop(started); });
+			}
+		}
+		runChunk = chunkFunction;
+		job = chunkJob;
+		jobChunks = chunkCount;
+		nextChunk = 0;
+		activeWorkers = static_cast<int>(threads.size());
+		generation++;
+		lock.unlock();
+		jobReady.notify_all();
+		runChunks();
+		lock.lock();
+		jobDone.wait(lock, [this] { return activeWorkers == 0; });
+	}
+
+public:
+	WorkerPool() {}
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+	~WorkerPool() {
+		stopWorkers();
+	}
+
+	//Threads taking part in job including calling thread, 0 takes all cores. Set between jobs, started workers are stopped
+	//and the next job starts new count of them
+	void setThreadCount(int count) {
+		if (count == threadLimit) {
+			return;
+		}
+		stopWorkers();
+		threadLimit = std::max(count, 0);
+	}
+	int threadCount() const { return threadLimit > 0 ? threadLimit : parallelThreadCount(); }
+
+	//Splits range [begin, end) into chunkCount contiguous chunks and calls function(chunkBegin, chunkEnd, chunkIndex) for each of them,
+	//chunks are spread over workers and calling thread. Chunks must write disjoint data (bands of scanlines, tiles of image).
+	template <typename Function>
+	void parallelFor(int begin, int end, int chunkCount, Function function) {
+		int count = end - begin;
+		if (count <= 0) {
+			return;
+		}
+		chunkCount = std::max(1, std::min(chunkCount, count));
+		auto chunk = [&function, begin, count, chunkCount](int index) {
+			function(begin + static_cast<int>(static_cast<qint64>(count) * index / chunkCount),
+				begin + static_cast<int>(static_cast<qint64>(count) * (index + 1) / chunkCount), index);
+		};
+		if (chunkCount == 1 || threadCount() == 1 || busy.exchange(true)) {
+			for (int index = 0; index < chunkCount; index++) {
+				chunk(index);
+			}
+			return;
+		}
+		run(chunkCount, &chunk, &invokeChunk<decltype(chunk)>);
+		busy = false;
+	}
+};
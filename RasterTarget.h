@@ -0,0 +1,78 @@
+#pragma once
+#include <QImage>
+#include <QColor>
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define RASTER_TARGET_SSE2
+#endif
+
+//Fills count 32-bit values starting at dst, four pixels per store where SSE2 is available
+inline void memset32(quint32* dst, quint32 value, qsizetype count) {
+#ifdef RASTER_TARGET_SSE2
+	//aligning destination to 16 bytes first
+	while (count > 0 && (reinterpret_cast<quintptr>(dst) & 15) != 0) {
+		*dst++ = value;
+		count--;
+	}
+	__m128i packed = _mm_set1_epi32(static_cast<int>(value));
+	for (; count >= 4; count -= 4, dst += 4) {
+		_mm_store_si128(reinterpret_cast<__m128i*>(dst), packed);
+	}
+#endif
+	std::fill_n(dst, count, value);
+}
+
+//Blends src over dst with coverage 0..256 in integer math, red/blue and alpha/green channels are processed in pairs
+inline QRgb blendRgb(QRgb dst, QRgb src, int coverage) {
+	quint32 inverse = 256 - coverage;
+	quint32 rb = ((src & 0xff00ff) * coverage + (dst & 0xff00ff) * inverse) >> 8;
+	quint32 ag = (((src >> 8) & 0xff00ff) * coverage + ((dst >> 8) & 0xff00ff) * inverse) >> 8;
+	return (rb & 0xff00ff) | ((ag & 0xff00ff) << 8);
+}
+
+//Raster target over 32-bit image (Format_ARGB32), pointer to pixels and pitch are cached when image is attached,
+//so every write is a single packed store. Callers clamp coordinates, no checks are made here.
+class RasterTarget {
+private:
+	uchar* bits = nullptr;
+	qsizetype pitch = 0;
+	int w = 0;
+	int h = 0;
+public:
+	RasterTarget() {};
+	explicit RasterTarget(QImage* image) { attach(image); }
+	void attach(QImage* image) {
+		if (image == nullptr) {
+			bits = nullptr;
+			pitch = 0;
+			w = 0;
+			h = 0;
+			return;
+		}
+		bits = image->bits();
+		pitch = image->bytesPerLine();
+		w = image->width();
+		h = image->height();
+	}
+	int width() const { return w; }
+	int height() const { return h; }
+	bool isInside(int x, int y) const { return x >= 0 && y >= 0 && x < w && y < h; }
+
+	quint32* row(int y) { return reinterpret_cast<quint32*>(bits + y * pitch); }
+	const quint32* row(int y) const { return reinterpret_cast<const quint32*>(bits + y * pitch); }
+	void setPixel(int x, int y, QRgb color) { row(y)[x] = color; }
+	QRgb pixel(int x, int y) const { return row(y)[x]; }
+	void blendPixel(int x, int y, QRgb color, int coverage) { row(y)[x] = blendRgb(row(y)[x], color, coverage); }
+	//fills pixels x0..x1 (both included) of row y
+	void fillSpan(int y, int x0, int x1, QRgb color) {
+		if (x1 >= x0) {
+			memset32(row(y) + x0, color, x1 - x0 + 1);
+		}
+	}
+	void fill(QRgb color) {
+		for (int y = 0; y < h; y++) {
+			memset32(row(y), color, w);
+		}
+	}
+};
@@ -0,0 +1,143 @@
+#pragma once
+#include <QVector>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <QColor>
+
+enum class RenderCommandType { Polyline, Circle, Ellipse, Polygon };
+
+//One recorded primitive, its points are range firstPoint .. firstPoint + pointCount - 1 of batch's point array,
+//bounding box is computed when command is recorded, so whole batch is clipped without touching points again
+struct RenderCommand {
+	RenderCommandType type = RenderCommandType::Polyline;
+	int layer = 0;
+	QColor color = Qt::black;
+	//line algorithm, 0 - DDA, 1 - Bresenham
+	int algType = 1;
+	int fillingAlgType = 0;
+	//closed polyline / filled circle or ellipse
+	bool closed = false;
+	int radius = 0;
+	//vertical radius of ellipse, radius is horizontal one
+	int radiusY = 0;
+	int firstPoint = 0;
+	int pointCount = 0;
+	QRect boundingBox;
+};
+
+//Command buffer of 2D primitives, recorded commands are drawn by ViewerWidget::submitBatch.
+//Lines are polylines of two points, points of all commands share one array, so clear() keeps capacity
+//and recording a frame into reused batch doesn't allocate.
+class RenderBatch {
+private:
+	QVector<RenderCommand> commands;
+	QVector<QPoint> points;
+	bool polylineOpen = false;
+
+	RenderCommand& beginCommand(RenderCommandType type, const QColor& color, int layer) {
+		RenderCommand command;
+		command.type = type;
+		command.color = color;
+		command.layer = layer;
+		command.firstPoint = points.length();
+		commands.append(command);
+		return commands.last();
+	}
+	void appendPoint(RenderCommand& command, QPoint point) {
+		command.boundingBox = command.pointCount == 0 ? QRect(point, point) : command.boundingBox | QRect(point, point);
+		points.append(point);
+		command.pointCount++;
+	}
+
+public:
+	void clear() {
+		commands.resize(0);
+		points.resize(0);
+		polylineOpen = false;
+	}
+	bool isEmpty() const { return commands.isEmpty(); }
+	int length() const { return commands.length(); }
+	const QVector<RenderCommand>& getCommands() const { return commands; }
+	const QPoint* commandPoints(const RenderCommand& command) const { return points.constData() + command.firstPoint; }
+
+	void addLine(QPoint start, QPoint end, const QColor& color, int layer = 0, int algType = 1) {
+		RenderCommand& command = beginCommand(RenderCommandType::Polyline, color, layer);
+		command.algType = algType;
+		appendPoint(command, start);
+		appendPoint(command, end);
+	}
+	void addPolyline(const QVector<QPoint>& polyline, const QColor& color, int layer = 0, bool closed = false, int algType = 1) {
+		if (polyline.length() < 2) {
+			return;
+		}
+		RenderCommand& command = beginCommand(RenderCommandType::Polyline, color, layer);
+		command.algType = algType;
+		command.closed = closed;
+		for (const QPoint& point : polyline) {
+			appendPoint(command, point);
+		}
+	}
+	//Flattened curve is rounded to pixels, points closer than a pixel fall together and are stored once
+	void addPolyline(const QVector<QPointF>& polyline, const QColor& color, int layer = 0) {
+		if (polyline.length() < 2) {
+			return;
+		}
+		RenderCommand& command = beginCommand(RenderCommandType::Polyline, color, layer);
+		for (const QPointF& point : polyline) {
+			QPoint rounded = point.toPoint();
+			if (command.pointCount == 0 || points.last() != rounded) {
+				appendPoint(command, rounded);
+			}
+		}
+		if (command.pointCount < 2) {
+			points.resize(command.firstPoint);
+			commands.removeLast();
+		}
+	}
+	//Polyline built point by point, used when its length isn't known in advance (wireframe edge chains)
+	void beginPolyline(const QColor& color, int layer = 0, int algType = 1) {
+		endPolyline();
+		beginCommand(RenderCommandType::Polyline, color, layer).algType = algType;
+		polylineOpen = true;
+	}
+	void addPolylinePoint(QPoint point) {
+		appendPoint(commands.last(), point);
+	}
+	void endPolyline() {
+		if (!polylineOpen) {
+			return;
+		}
+		polylineOpen = false;
+		if (commands.last().pointCount < 2) {
+			points.resize(commands.last().firstPoint);
+			commands.removeLast();
+		}
+	}
+	void addCircle(QPoint center, int r, const QColor& color, int layer = 0, bool filled = false) {
+		RenderCommand& command = beginCommand(RenderCommandType::Circle, color, layer);
+		command.radius = r;
+		command.closed = filled;
+		appendPoint(command, center);
+		command.boundingBox = QRect(center.x() - r, center.y() - r, 2 * r + 1, 2 * r + 1);
+	}
+	void addEllipse(QPoint center, int rx, int ry, const QColor& color, int layer = 0, bool filled = false) {
+		RenderCommand& command = beginCommand(RenderCommandType::Ellipse, color, layer);
+		command.radius = rx;
+		command.radiusY = ry;
+		command.closed = filled;
+		appendPoint(command, center);
+		command.boundingBox = QRect(center.x() - rx, center.y() - ry, 2 * rx + 1, 2 * ry + 1);
+	}
+	void addPolygon(const QVector<QPoint>& polygon, const QColor& color, int layer = 0, int algType = 1, int fillingAlgType = 0) {
+		if (polygon.length() <= 2) {
+			return;
+		}
+		RenderCommand& command = beginCommand(RenderCommandType::Polygon, color, layer);
+		command.algType = algType;
+		command.fillingAlgType = fillingAlgType;
+		for (const QPoint& point : polygon) {
+			appendPoint(command, point);
+		}
+	}
+};
@@ -0,0 +1,180 @@
+//Command-line batch renderer, renders VTK files headlessly into PNG images
+//usage: RenderCli [options] file1.vtk file2.vtk ...
+#include "Renderer.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFileInfo>
+#include <QThread>
+#include <atomic>
+#include <thread>
+
+struct RenderSettings {
+	QSize size = QSize(700, 700);
+	QString outputDir = ".";
+	//same codes as combo boxes of viewer, 0 - orthogonal, 1 - perspective / 0 - wire-frame, 1 - surface / 0 - flat, 1 - Gouraud
+	int projectionType = 0;
+	int representationType = 1;
+	int shadingType = 0;
+	double cameraZ = 1000;
+	//degrees
+	double azimut = 0;
+	double zenit = 0;
+	//orbit sequence, every frame moves view by given steps
+	int frames = 1;
+	double azimutStep = 0;
+	double zenitStep = 0;
+	bool antialiasing = false;
+	bool hiddenLineRemoval = false;
+	bool lightEnabled = false;
+	LightSettings light;
+};
+
+//Parses "a,b,c" into three numbers, returns false when format doesn't match
+static bool parseTriple(const QString& text, double values[3]) {
+	QStringList parts = text.split(',');
+	if (parts.length() != 3) {
+		return false;
+	}
+	for (int i = 0; i < 3; i++) {
+		bool ok = false;
+		values[i] = parts[i].trimmed().toDouble(&ok);
+		if (!ok) {
+			return false;
+		}
+	}
+	return true;
+}
+
+//Renders all frames of one file, returns number of written images
+static int renderFile(Renderer& renderer, const QString& fileName, const RenderSettings& settings) {
+	Object_H_edge object = loadPolygonsVTK(fileName);
+	if (object.vertices.isEmpty()) {
+		qDebug() << fileName << " : nothing to render";
+		return 0;
+	}
+	renderer.invalidateProjection();
+	renderer.setAntialiasing(settings.antialiasing);
+	renderer.setHiddenLineRemoval(settings.hiddenLineRemoval);
+	renderer.getCamera().position.z = settings.cameraZ;
+	QString baseName = QDir(settings.outputDir).filePath(QFileInfo(fileName).completeBaseName());
+	int written = 0;
+	for (int frame = 0; frame < settings.frames; frame++) {
+		double azimut = (settings.azimut + frame * settings.azimutStep) * M_PI / 180;
+		double zenit = (settings.zenit + frame * settings.zenitStep) * M_PI / 180;
+		renderer.getProjectionPlane().setProjectionPlane(azimut, zenit);
+		renderer.clear();
+		renderer.drawObject(object, settings.projectionType, settings.representationType, settings.shadingType,
+			settings.lightEnabled ? &settings.light : nullptr);
+		QString outputName = settings.frames > 1 ? QString("%1_%2.png").arg(baseName).arg(frame, 4, 10, QChar('0')) : baseName + ".png";
+		if (renderer.getImage()->save(outputName, "PNG")) {
+			written++;
+		}
+		else {
+			qDebug() << outputName << " : image failed to save";
+		}
+	}
+	object.release();
+	return written;
+}
+
+int main(int argc, char* argv[])
+{
+	QLocale::setDefault(QLocale::c());
+	QCoreApplication app(argc, argv);
+	QCoreApplication::setApplicationName("RenderCli");
+
+	QCommandLineParser parser;
+	parser.setApplicationDescription("Renders VTK polygon files into PNG images without display.");
+	parser.addHelpOption();
+	parser.addPositionalArgument("files", "VTK files to render.", "files...");
+	QCommandLineOption outputOption({ "o", "output" }, "Output directory.", "dir", ".");
+	QCommandLineOption sizeOption("size", "Image size WIDTHxHEIGHT.", "size", "700x700");
+	QCommandLineOption projectionOption("projection", "0 - orthogonal, 1 - perspective.", "type", "0");
+	QCommandLineOption representationOption("representation", "0 - wire-frame, 1 - surface, 2 - surface by painter's algorithm, 3 - surface by BSP tree.", "type", "1");
+	QCommandLineOption shadingOption("shading", "0 - flat, 1 - Gouraud.", "type", "0");
+	QCommandLineOption cameraOption("camera-z", "Camera distance for perspective projection.", "z", "1000");
+	QCommandLineOption azimutOption("azimuth", "Azimuth of view in degrees.", "degrees", "0");
+	QCommandLineOption zenitOption("zenith", "Zenith of view in degrees.", "degrees", "0");
+	QCommandLineOption framesOption("frames", "Number of frames of orbit sequence.", "count", "1");
+	QCommandLineOption azimutStepOption("azimuth-step", "Azimuth change between frames in degrees.", "degrees", "0");
+	QCommandLineOption zenitStepOption("zenith-step", "Zenith change between frames in degrees.", "degrees", "0");
+	QCommandLineOption lightOption("light", "Enables lighting, same defaults as viewer.");
+	QCommandLineOption lightPositionOption("light-position", "Light position x,y,z.", "x,y,z", "500,500,100");
+	QCommandLineOption lightIntensityOption("light-intensity", "Light intensity r,g,b.", "r,g,b", "255,255,255");
+	QCommandLineOption ambientIntensityOption("ambient-intensity", "Ambient light intensity r,g,b.", "r,g,b", "0,0,255");
+	QCommandLineOption rsOption("rs", "Mirror reflection coefficient.", "value", "0.5");
+	QCommandLineOption rdOption("rd", "Diffuse reflection coefficient.", "value", "0.5");
+	QCommandLineOption raOption("ra", "Ambient reflection coefficient.", "value", "0.5");
+	QCommandLineOption hOption("sharpness", "Mirror reflection sharpness.", "value", "1");
+	QCommandLineOption antialiasingOption("antialiasing", "Anti-aliased lines.");
+	QCommandLineOption hiddenLinesOption("hidden-lines", "Removes hidden lines of wire-frame.");
+	QCommandLineOption jobsOption({ "j", "jobs" }, "Number of files rendered at once, all cores by default.", "count", QString::number(QThread::idealThreadCount()));
+	parser.addOptions({ outputOption, sizeOption, projectionOption, representationOption, shadingOption, cameraOption, azimutOption, zenitOption,
+		framesOption, azimutStepOption, zenitStepOption, lightOption, lightPositionOption, lightIntensityOption, ambientIntensityOption,
+		rsOption, rdOption, raOption, hOption, antialiasingOption, hiddenLinesOption, jobsOption });
+	parser.process(app);
+
+	const QStringList files = parser.positionalArguments();
+	if (files.isEmpty()) {
+		parser.showHelp(1);
+	}
+	RenderSettings settings;
+	QStringList size = parser.value(sizeOption).split('x');
+	if (size.length() != 2 || size[0].toInt() <= 0 || size[1].toInt() <= 0) {
+		qDebug() << "invalid size : " << parser.value(sizeOption);
+		return 1;
+	}
+	settings.size = QSize(size[0].toInt(), size[1].toInt());
+	settings.outputDir = parser.value(outputOption);
+	settings.projectionType = parser.value(projectionOption).toInt();
+	settings.representationType = parser.value(representationOption).toInt();
+	settings.shadingType = parser.value(shadingOption).toInt();
+	settings.cameraZ = parser.value(cameraOption).toDouble();
+	settings.azimut = parser.value(azimutOption).toDouble();
+	settings.zenit = parser.value(zenitOption).toDouble();
+	settings.frames = std::max(parser.value(framesOption).toInt(), 1);
+	settings.azimutStep = parser.value(azimutStepOption).toDouble();
+	settings.zenitStep = parser.value(zenitStepOption).toDouble();
+	settings.antialiasing = parser.isSet(antialiasingOption);
+	settings.hiddenLineRemoval = parser.isSet(hiddenLinesOption);
+	settings.lightEnabled = parser.isSet(lightOption);
+	double position[3], intensity[3], ambient[3];
+	if (!parseTriple(parser.value(lightPositionOption), position) || !parseTriple(parser.value(lightIntensityOption), intensity) ||
+		!parseTriple(parser.value(ambientIntensityOption), ambient)) {
+		qDebug() << "invalid light settings";
+		return 1;
+	}
+	settings.light = LightSettings(Vertex(position[0], position[1], position[2]), parser.value(rsOption).toDouble(), parser.value(rdOption).toDouble(),
+		parser.value(raOption).toDouble(), parser.value(hOption).toInt(), QColor(static_cast<int>(intensity[0]), static_cast<int>(intensity[1]), static_cast<int>(intensity[2])),
+		QColor(static_cast<int>(ambient[0]), static_cast<int>(ambient[1]), static_cast<int>(ambient[2])));
+	if (!QDir().mkpath(settings.outputDir)) {
+		qDebug() << settings.outputDir << " : output directory can't be created";
+		return 1;
+	}
+
+	//every worker has its own renderer and takes next file when it's done with previous one,
+	//renderers of parallel jobs draw on their own thread only, so there are jobs threads instead of jobs times cores
+	int jobs = std::min(std::max(parser.value(jobsOption).toInt(), 1), static_cast<int>(files.length()));
+	std::atomic<int> nextFile(0);
+	std::atomic<int> written(0);
+	auto worker = [&]() {
+		Renderer renderer(settings.size);
+		if (jobs > 1) {
+			renderer.setThreadCount(1);
+		}
+		for (int i = nextFile++; i < files.length(); i = nextFile++) {
+			written += renderFile(renderer, files[i], settings);
+		}
+	};
+	std::vector<std::thread> threads;
+	for (int i = 1; i < jobs; i++) {
+		threads.emplace_back(worker);
+	}
+	worker();
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+	qDebug() << written.load() << " images written";
+	return written.load() == files.length() * settings.frames ? 0 : 1;
+}
@@ -0,0 +1,3354 @@
+#include "Renderer.h"
+#include "CurveTessellation.h"
+#include "MeshSimplification.h"
+#include <QFile>
+#include <QDir>
+#include <QTextStream>
+#include <regex>
+#include <QHash>
+#include <random>
+#include <climits>
+#include <cfloat>
+
+#define VTK_FILE_HEADER "#vtk DataFile Version 3.0\nvtk output\nASCII\nDATASET POLYDATA\n"
+
+Renderer::Renderer(QSize imgSize)
+{
+	if (imgSize != QSize(0, 0)) {
+		img = new QImage(imgSize, QImage::Format_ARGB32);
+		img->fill(Qt::white);
+		setPainter();
+		setDataPtr();
+	}
+}
+Renderer::Renderer(uchar* buffer, int width, int height, qsizetype bytesPerLine)
+{
+	//pixels stay owned by caller and keep their content, image only wraps them
+	img = new QImage(buffer, width, height, bytesPerLine, QImage::Format_ARGB32);
+	setPainter();
+	setDataPtr();
+}
+Renderer::~Renderer()
+{
+	stopLevelOfDetail();
+	scene.clear();
+	delete painter;
+	delete img;
+}
+
+//Image functions
+bool Renderer::setImage(const QImage& inputImg)
+{
+	if (img != nullptr) {
+		delete painter;
+		delete img;
+	}
+	img = new QImage(inputImg);
+	if (!img) {
+		return false;
+	}
+	setPainter();
+	setDataPtr();
+	imageChanged(img->rect());
+
+	return true;
+}
+bool Renderer::isEmpty()
+{
+	if (img == nullptr) {
+		return true;
+	}
+
+	if (img->size() == QSize(0, 0)) {
+		return true;
+	}
+	return false;
+}
+bool Renderer::changeSize(int width, int height)
+{
+	QSize newSize(width, height);
+
+	if (newSize != QSize(0, 0)) {
+		if (img != nullptr) {
+			delete painter;
+			delete img;
+		}
+
+		img = new QImage(newSize, QImage::Format_ARGB32);
+		if (!img) {
+			return false;
+		}
+		img->fill(Qt::white);
+		setPainter();
+		setDataPtr();
+		imageChanged(img->rect());
+	}
+
+	return true;
+}
+void Renderer::resetZBuffer()
+{
+	//depth array is one block of width * height values, reallocated only when image size changes
+	int size = img->width() * img->height();
+	resetHierarchicalDepth();
+	if (z_buffer_layer_array.length() != size) {
+		z_buffer_layer_array = QVector<double>(size, -DBL_MAX);
+		return;
+	}
+	std::fill(z_buffer_layer_array.begin(), z_buffer_layer_array.end(), -DBL_MAX);
+}
+void Renderer::beginSurfaceFrame() {
+	//buffers of other visibility modes are released, so memory of one mode is held at a time
+	if (surfaceVisibility != 1) {
+		orderedTriangles = QVector<SurfaceTriangle>();
+		triangleDepths = QVector<double>();
+		triangleDepthRanges = QVector<QPair<double, double>>();
+		triangleKeys = QVector<quint32>();
+		triangleKeysScratch = QVector<quint32>();
+		triangleOrderScratch = QVector<int>();
+	}
+	if (surfaceVisibility != 2) {
+		bspTrees.clear();
+		bspProjected = QVector<Vertex>();
+		bspStack = QVector<int>();
+	}
+	if (surfaceVisibility == 0) {
+		triangleOrder = QVector<int>();
+		resetZBuffer();
+		return;
+	}
+	//triangles are drawn back to front, no depth of pixels is kept, next Z-buffer frame allocates it again
+	z_buffer_layer_array = QVector<double>();
+	hiZLevels.clear();
+	hiZSizes.clear();
+}
+qint64 Renderer::visibilityMemory() const {
+	qint64 bytes = z_buffer_layer_array.capacity() * sizeof(double);
+	for (const QVector<double>& level : hiZLevels) {
+		bytes += level.capacity() * sizeof(double);
+	}
+	bytes += orderedTriangles.capacity() * sizeof(SurfaceTriangle) + triangleDepths.capacity() * sizeof(double) + triangleDepthRanges.capacity() * sizeof(QPair<double, double>) +
+		(triangleKeys.capacity() + triangleKeysScratch.capacity()) * sizeof(quint32) + (triangleOrder.capacity() + triangleOrderScratch.capacity()) * sizeof(int);
+	for (const BspTree& tree : bspTrees) {
+		bytes += tree.memoryBytes();
+	}
+	bytes += bspProjected.capacity() * sizeof(Vertex) + bspStack.capacity() * sizeof(int);
+	return bytes;
+}
+void Renderer::resetHierarchicalDepth() {
+	//tile of level 0 is 8x8 pixels, levels go up to single tile
+	QSize size((img->width() + 7) / 8, (img->height() + 7) / 8);
+	if (hiZSizes.isEmpty() || hiZSizes[0] != size) {
+		hiZSizes.clear();
+		hiZLevels.clear();
+		while (true) {
+			hiZSizes.append(size);
+			hiZLevels.append(QVector<double>(size.width() * size.height(), -DBL_MAX));
+			if (size.width() <= 1 && size.height() <= 1) {
+				break;
+			}
+			size = QSize((size.width() + 1) / 2, (size.height() + 1) / 2);
+		}
+		return;
+	}
+	for (QVector<double>& level : hiZLevels) {
+		std::fill(level.begin(), level.end(), -DBL_MAX);
+	}
+}
+void Renderer::refreshHierarchicalDepth(const QRect& region) {
+	QRect area = region.intersected(img->rect());
+	if (area.isEmpty() || hiZLevels.isEmpty()) {
+		return;
+	}
+	const int width = img->width();
+	const int height = img->height();
+	int tx0 = area.left() / 8, tx1 = area.right() / 8;
+	int ty0 = area.top() / 8, ty1 = area.bottom() / 8;
+	QVector<double>& tiles = hiZLevels[0];
+	for (int ty = ty0; ty <= ty1; ty++) {
+		for (int tx = tx0; tx <= tx1; tx++) {
+			double farthest = DBL_MAX;
+			for (int y = ty * 8; y < std::min(ty * 8 + 8, height); y++) {
+				const double* row = z_buffer_layer_array.constData() + static_cast<qsizetype>(y) * width;
+				for (int x = tx * 8; x < std::min(tx * 8 + 8, width); x++) {
+					farthest = std::min(farthest, row[x]);
+				}
+			}
+			tiles[ty * hiZSizes[0].width() + tx] = farthest;
+		}
+	}
+	//parents of refreshed tiles, tiles of image border may have only some children
+	for (int level = 1; level < hiZLevels.length(); level++) {
+		tx0 /= 2; tx1 /= 2; ty0 /= 2; ty1 /= 2;
+		const QVector<double>& children = hiZLevels[level - 1];
+		const QSize childSize = hiZSizes[level - 1];
+		QVector<double>& parents = hiZLevels[level];
+		for (int ty = ty0; ty <= ty1; ty++) {
+			for (int tx = tx0; tx <= tx1; tx++) {
+				double farthest = DBL_MAX;
+				for (int cy = 2 * ty; cy < std::min(2 * ty + 2, childSize.height()); cy++) {
+					for (int cx = 2 * tx; cx < std::min(2 * tx + 2, childSize.width()); cx++) {
+						farthest = std::min(farthest, children[cy * childSize.width() + cx]);
+					}
+				}
+				parents[ty * hiZSizes[level].width() + tx] = farthest;
+			}
+		}
+	}
+}
+void Renderer::setPixel(int x, int y, uchar r, uchar g, uchar b, uchar a)
+{
+	target.setPixel(x, y, qRgba(r, g, b, a));
+}
+void Renderer::setPixel(int x, int y, double valR, double valG, double valB, double valA)
+{
+	valR = valR > 1 ? 1 : (valR < 0 ? 0 : valR);
+	valG = valG > 1 ? 1 : (valG < 0 ? 0 : valG);
+	valB = valB > 1 ? 1 : (valB < 0 ? 0 : valB);
+	valA = valA > 1 ? 1 : (valA < 0 ? 0 : valA);
+
+	target.setPixel(x, y, qRgba(static_cast<int>(255 * valR), static_cast<int>(255 * valG), static_cast<int>(255 * valB), static_cast<int>(255 * valA)));
+}
+void Renderer::setPixel(int x, int y, const QColor& color)
+{
+	if (color.isValid()) {
+		target.setPixel(x, y, color.rgba());
+	}
+}
+void Renderer::plotPixel(int x, int y, QRgb color)
+{
+	target.setPixel(x, y, color);
+}
+void Renderer::plotPixelCoverage(int x, int y, QRgb color, int coverage)
+{
+	if (coverage >= 256) {
+		plotPixel(x, y, color);
+		return;
+	}
+	if (coverage <= 0) {
+		return;
+	}
+	target.blendPixel(x, y, color, coverage);
+}
+void Renderer::plotSpan(int y, int x0, int x1, QRgb color)
+{
+	target.fillSpan(y, x0, x1, color);
+}
+
+//Draw functions
+//2D draw functions
+void Renderer::drawLine(QPoint start, QPoint end, const QColor& color, int algType)
+{
+	if (!croppedBySutherlandHodgman) {
+		//lines inside guard band are only clamped by rasterizer, clipping runs just for lines crossing the band
+		QRect boundingBox = QRect(start, end).normalized();
+		if (isInsideGuardBand(boundingBox)) {
+			if (!boundingBox.intersects(img->rect())) {
+				return;
+			}
+		}
+		else if (!cyrusBeck(start, end)) {
+			//qDebug() << "drawing line: none";
+			return;
+		}
+	}
+	if (antialiasing) {
+		drawLineWu(start, end, color);
+	}
+	else if (algType == 0) { //DDA
+		drawLineDDA(start, end, color);
+	}
+	else if (algType == 1) { //Bresenham
+		drawLineBresenham(start, end, color);
+	}
+	//drawCircleBresenham(start, start + QPoint(0, 2), Qt::red);
+	//drawCircleBresenham(end, end + QPoint(0, 2), Qt::red);
+	requestUpdate();
+}
+void Renderer::drawCircleBresenham(QPoint start, QPoint end, const QColor& color) {
+	if (antialiasing) {
+		drawCircleWu(start, sqrt(pow(end.x() - start.x(), 2) + pow(end.y() - start.y(), 2)), color);
+		return;
+	}
+	drawCircle(start, static_cast<int>(sqrt(pow(end.x() - start.x(), 2) + pow(end.y() - start.y(), 2))), color);
+	requestUpdate();
+}
+ClipResult Renderer::classifyBoundingBox(const QRect& boundingBox) {
+	if (img->rect().contains(boundingBox)) {
+		return ClipResult::Inside;
+	}
+	return img->rect().intersects(boundingBox) ? ClipResult::Partial : ClipResult::Outside;
+}
+void Renderer::plotClampedSpan(int y, int x0, int x1, QRgb color) {
+	if (y < 0 || y >= target.height()) {
+		return;
+	}
+	plotSpan(y, std::max(x0, 0), std::min(x1, target.width() - 1), color);
+}
+void Renderer::drawCircle(QPoint center, int r, const QColor& color, bool filled) {
+	if (r < 0) {
+		return;
+	}
+	ClipResult clipping = classifyBoundingBox(QRect(center.x() - r, center.y() - r, 2 * r + 1, 2 * r + 1));
+	if (clipping == ClipResult::Outside) {
+		return;
+	}
+	QRgb rgb = color.rgba();
+	if (filled) {
+		shapeHalfWidths.fill(0, r + 1);
+	}
+	int x = 0, twoX = 3;
+	int y = r, twoY = 2 * r - 2;
+	int pCurrent = 1 - r;
+	for (x = 0; x <= y; x++) {
+		if (filled) {
+			//widest point of every row, spans are written once circle is finished
+			shapeHalfWidths[y] = std::max(shapeHalfWidths[y], x);
+			shapeHalfWidths[x] = std::max(shapeHalfWidths[x], y);
+		}
+		else {
+			//one computed point is mirrored into all eight octants, circle fully inside image needs no checks
+			const QPoint octants[8] = { QPoint(y, x), QPoint(x, y), QPoint(x, -y), QPoint(-y, x), QPoint(-y, -x), QPoint(-x, -y), QPoint(-x, y), QPoint(y, -x) };
+			for (const QPoint& octant : octants) {
+				QPoint P = center + octant;
+				if (clipping == ClipResult::Inside || target.isInside(P.x(), P.y())) {
+					plotPixel(P.x(), P.y(), rgb);
+				}
+			}
+		}
+		if (pCurrent > 0) {
+			pCurrent = pCurrent - twoY;
+			y--;
+			twoY -= 2;
+		}
+		pCurrent += twoX;
+		twoX += 2;
+	}
+	if (filled) {
+		for (int dy = 0; dy <= r; dy++) {
+			plotClampedSpan(center.y() + dy, center.x() - shapeHalfWidths[dy], center.x() + shapeHalfWidths[dy], rgb);
+			if (dy != 0) {
+				plotClampedSpan(center.y() - dy, center.x() - shapeHalfWidths[dy], center.x() + shapeHalfWidths[dy], rgb);
+			}
+		}
+	}
+}
+void Renderer::drawEllipse(QPoint center, int rx, int ry, const QColor& color, bool filled) {
+	if (rx < 0 || ry < 0) {
+		return;
+	}
+	ClipResult clipping = classifyBoundingBox(QRect(center.x() - rx, center.y() - ry, 2 * rx + 1, 2 * ry + 1));
+	if (clipping == ClipResult::Outside) {
+		return;
+	}
+	QRgb rgb = color.rgba();
+	//ellipse with zero radius degenerates to line along other axis, filled or not
+	if (ry == 0) {
+		plotClampedSpan(center.y(), center.x() - rx, center.x() + rx, rgb);
+		return;
+	}
+	if (rx == 0) {
+		if (center.x() >= 0 && center.x() < target.width()) {
+			for (int y = std::max(center.y() - ry, 0); y <= std::min(center.y() + ry, target.height() - 1); y++) {
+				plotPixel(center.x(), y, rgb);
+			}
+		}
+		return;
+	}
+	if (filled) {
+		shapeHalfWidths.fill(0, ry + 1);
+	}
+	//one computed point is mirrored into all four quadrants
+	auto plotQuadrants = [&](int x, int y) {
+		if (filled) {
+			shapeHalfWidths[y] = std::max(shapeHalfWidths[y], x);
+			return;
+		}
+		const QPoint quadrants[4] = { QPoint(x, y), QPoint(-x, y), QPoint(x, -y), QPoint(-x, -y) };
+		for (const QPoint& quadrant : quadrants) {
+			QPoint P = center + quadrant;
+			if (clipping == ClipResult::Inside || target.isInside(P.x(), P.y())) {
+				plotPixel(P.x(), P.y(), rgb);
+			}
+		}
+	};
+	//midpoint algorithm, first region steps in x while slope is above -1, second region steps in y
+	const qint64 rx2 = static_cast<qint64>(rx) * rx;
+	const qint64 ry2 = static_cast<qint64>(ry) * ry;
+	int x = 0;
+	int y = ry;
+	qint64 dx = 0;
+	qint64 dy = 2 * rx2 * y;
+	double d1 = ry2 - rx2 * ry + 0.25 * rx2;
+	while (dx < dy) {
+		plotQuadrants(x, y);
+		x++;
+		dx += 2 * ry2;
+		if (d1 < 0) {
+			d1 += dx + ry2;
+		}
+		else {
+			y--;
+			dy -= 2 * rx2;
+			d1 += dx - dy + ry2;
+		}
+	}
+	double d2 = ry2 * (x + 0.5) * (x + 0.5) + rx2 * static_cast<double>(y - 1) * (y - 1) - rx2 * ry2;
+	while (y >= 0) {
+		plotQuadrants(x, y);
+		y--;
+		dy -= 2 * rx2;
+		if (d2 > 0) {
+			d2 += rx2 - dy;
+		}
+		else {
+			x++;
+			dx += 2 * ry2;
+			d2 += dx - dy + rx2;
+		}
+	}
+	if (filled) {
+		for (int row = 0; row <= ry; row++) {
+			plotClampedSpan(center.y() + row, center.x() - shapeHalfWidths[row], center.x() + shapeHalfWidths[row], rgb);
+			if (row != 0) {
+				plotClampedSpan(center.y() - row, center.x() - shapeHalfWidths[row], center.x() + shapeHalfWidths[row], rgb);
+			}
+		}
+	}
+}
+void Renderer::drawLineDDA(QPoint start, QPoint end, const QColor& color) {
+	QRgb rgb = color.rgba();
+	if (start.x() != end.x()) {
+		double m = (static_cast<double>(end.y()) - static_cast<double>(start.y())) / (static_cast<double>(end.x()) - static_cast<double>(start.x()));
+		if (abs(m) <= 1) { //riadiaca os X
+			if (start.x() > end.x()) {
+				std::swap(start, end);
+			}
+			//span of driving axis is clamped to image
+			int xBegin = std::max(start.x(), 0);
+			int xEnd = std::min(end.x(), img->width());
+			double y = start.y() + m * (xBegin - start.x());
+			for (int x = xBegin; x < xEnd; x++) {
+				int yPixel = static_cast<int>(y + 0.5);
+				if (yPixel >= 0 && yPixel < target.height()) {
+					plotPixel(x, yPixel, rgb);
+				}
+				y += m;
+			}
+		}
+		else { //riadiaca os Y
+			if (start.y() > end.y()) {
+				std::swap(start, end);
+			}
+			int yBegin = std::max(start.y(), 0);
+			int yEnd = std::min(end.y(), img->height());
+			double x = start.x() + (yBegin - start.y()) / m;
+			for (int y = yBegin; y < yEnd; y++) {
+				int xPixel = static_cast<int>(x + 0.5);
+				if (xPixel >= 0 && xPixel < target.width()) {
+					plotPixel(xPixel, y, rgb);
+				}
+				x += 1 / m;
+			}
+		}
+	}
+	else {
+		if (start.y() > end.y()) {
+			std::swap(start, end);
+		}
+		if (start.x() < 0 || start.x() >= target.width()) {
+			return;
+		}
+		for (int y = std::max(start.y(), 0); y < std::min(end.y(), img->height()); y++) {
+			plotPixel(start.x(), y, rgb);
+		}
+	}
+}
+void Renderer::drawLineBresenham(QPoint start, QPoint end, const QColor& color) {
+	QRgb rgb = color.rgba();
+	if (start.x() == end.x()) {
+		if (start.y() > end.y()) {
+			std::swap(start, end);
+		}
+		if (start.x() < 0 || start.x() >= target.width()) {
+			return;
+		}
+		for (int y = std::max(start.y(), 0); y <= std::min(end.y(), img->height() - 1); y++) {
+			plotPixel(start.x(), y, rgb);
+		}
+		return;
+	}
+	double m = (static_cast<double>(end.y()) - static_cast<double>(start.y())) / (static_cast<double>(end.x()) - static_cast<double>(start.x()));
+	int tmp = 0;
+	if (abs(m) <= 1) {									// riadiaca os X
+		if (start.x() > end.x()) {
+			std::swap(start, end);
+		}
+		int twoDeltaX = 2 * (end.x() - start.x());
+		int twoDeltaY = 2 * (end.y() - start.y());
+		if (0 < m  && m <= 1) {
+			tmp = -1;
+		}
+		else {
+			tmp = 1;
+		}
+		int k1 = twoDeltaY;
+		int k2 = twoDeltaY + tmp * twoDeltaX;
+		int pCurrent = twoDeltaY + tmp * twoDeltaX / 2;
+		int y = start.y();
+		if (target.isInside(start.x(), start.y())) {
+			plotPixel(start.x(), start.y(), rgb);
+		}
+		//span is clamped to right edge of image, line which left image vertically doesn't come back
+		int xLast = std::min(end.x(), img->width() - 1);
+		for (int x = start.x(); x <= xLast; x++) {
+
+			if (tmp == -1) {							// m patri ]0,1]
+				if (pCurrent > 0) {
+					y++;
+					pCurrent += k2;
+				}
+				else {
+					pCurrent += k1;
+				}
+			}
+			else {										// m patri [-1,0]
+				if (pCurrent < 0) {
+					y--;
+					pCurrent += k2;
+				}
+				else {
+					pCurrent += k1;
+				}
+			}
+			if ((tmp == -1 && y >= img->height()) || (tmp == 1 && y < 0)) {
+				break;
+			}
+			if (target.isInside(x, y)) {
+				plotPixel(x, y, rgb);
+			}
+		}
+
+	}
+	else {												// riadiaca os Y
+		if (start.y() > end.y()) {
+			std::swap(start, end);
+		}
+		int twoDeltaX = 2 * (end.x() - start.x());
+		int twoDeltaY = 2 * (end.y() - start.y());
+		if (m > 1) {
+			tmp = -1;
+		}
+		else {
+			tmp = 1;
+		}
+		int x = start.x();
+		int pCurrent = twoDeltaX + tmp * twoDeltaY / 2;
+		int k1 = twoDeltaX;
+		int k2 = twoDeltaX + tmp * twoDeltaY;
+		if (target.isInside(start.x(), start.y())) {
+			plotPixel(start.x(), start.y(), rgb);
+		}
+		int yLast = std::min(end.y(), img->height() - 1);
+		for (int y = start.y(); y <= yLast; y++) {
+			if (tmp == -1) {							// m > 1
+				if (pCurrent > 0) {
+					x++;
+					pCurrent += k2;
+				}
+				else {
+					pCurrent += k1;
+				}
+			}
+			else {										// m < -1 
+				if (pCurrent < 0) {
+					x--;
+					pCurrent += k2;
+				}
+				else {
+					pCurrent += k1;
+				}
+			}
+			if ((tmp == -1 && x >= img->width()) || (tmp == 1 && x < 0)) {
+				break;
+			}
+			if (target.isInside(x, y)) {
+				plotPixel(x, y, rgb);
+			}
+		}
+	}
+}
+void Renderer::drawLineWu(QPoint start, QPoint end, const QColor& color) {
+	QRgb rgb = color.rgba();
+	//steep line is drawn in swapped coordinates, so driving axis is always x
+	bool steep = abs(end.y() - start.y()) > abs(end.x() - start.x());
+	if (steep) {
+		start = QPoint(start.y(), start.x());
+		end = QPoint(end.y(), end.x());
+	}
+	if (start.x() > end.x()) {
+		std::swap(start, end);
+	}
+	int majorLimit = steep ? target.height() : target.width();
+	int minorLimit = steep ? target.width() : target.height();
+	auto plot = [&](int x, int y, int coverage) {
+		if (y >= 0 && y < minorLimit) {
+			if (steep) {
+				plotPixelCoverage(y, x, rgb, coverage);
+			}
+			else {
+				plotPixelCoverage(x, y, rgb, coverage);
+			}
+		}
+	};
+	int dx = end.x() - start.x();
+	if (dx == 0) {
+		if (start.x() >= 0 && start.x() < majorLimit) {
+			plot(start.x(), start.y(), 256);
+		}
+		return;
+	}
+	//position on minor axis in 16.16 fixed point, its fraction splits coverage between two neighbouring pixels
+	qint64 gradient = (static_cast<qint64>(end.y() - start.y()) << 16) / dx;
+	int xBegin = std::max(start.x(), 0);
+	int xEnd = std::min(end.x(), majorLimit - 1);
+	qint64 minor = (static_cast<qint64>(start.y()) << 16) + gradient * (xBegin - start.x());
+	for (int x = xBegin; x <= xEnd; x++) {
+		int y = static_cast<int>(minor >> 16);
+		int fraction = static_cast<int>((minor >> 8) & 0xff);
+		plot(x, y, 256 - fraction);
+		plot(x, y + 1, fraction);
+		minor += gradient;
+	}
+}
+void Renderer::drawCircleWu(QPoint center, double r, const QColor& color) {
+	QRgb rgb = color.rgba();
+	auto plot = [&](int x, int y, int coverage) {
+		if (target.isInside(x, y)) {
+			plotPixelCoverage(x, y, rgb, coverage);
+		}
+	};
+	//exact y of circle in every column of first octant, pixels on both sides of it share coverage
+	for (int x = 0; x <= r; x++) {
+		double yExact = sqrt(r * r - x * x);
+		if (x > yExact) {
+			break;
+		}
+		int y = static_cast<int>(yExact);
+		int fraction = static_cast<int>((yExact - y) * 256);
+		const QPoint octants[8] = { QPoint(y, x), QPoint(x, y), QPoint(x, -y), QPoint(-y, x), QPoint(-y, -x), QPoint(-x, -y), QPoint(-x, y), QPoint(y, -x) };
+		const QPoint outer[8] = { QPoint(1, 0), QPoint(0, 1), QPoint(0, -1), QPoint(-1, 0), QPoint(-1, 0), QPoint(0, -1), QPoint(0, 1), QPoint(1, 0) };
+		for (int i = 0; i < 8; i++) {
+			//octants meet on axes and diagonal, pixel shared by them is blended only once
+			bool repeated = false, repeatedOuter = false;
+			for (int j = 0; j < i; j++) {
+				if (octants[j] == octants[i]) {
+					repeated = true;
+					repeatedOuter = repeatedOuter || outer[j] == outer[i];
+				}
+			}
+			QPoint P = center + octants[i];
+			if (!repeated) {
+				plot(P.x(), P.y(), 256 - fraction);
+			}
+			if (!repeatedOuter) {
+				plot(P.x() + outer[i].x(), P.y() + outer[i].y(), fraction);
+			}
+		}
+	}
+	requestUpdate();
+}
+//Accumulates signed area which edge covers in every pixel of its scanlines into buffer of rows with stride floats,
+//running sum over row then gives winding number of pixels, which fill rule turns into coverage
+static void accumulateCoverageEdge(float* accumulation, int stride, int rows, QPointF P0, QPointF P1) {
+	if (P0.y() == P1.y()) {
+		return;
+	}
+	float direction = 1;
+	if (P0.y() > P1.y()) {
+		std::swap(P0, P1);
+		direction = -1;
+	}
+	double dxdy = (P1.x() - P0.x()) / (P1.y() - P0.y());
+	double x = P0.x();
+	int yBegin = std::max(static_cast<int>(P0.y()), 0);
+	if (P0.y() < 0) {
+		x -= P0.y() * dxdy;
+	}
+	int yEnd = std::min(rows, static_cast<int>(ceil(P1.y())));
+	for (int y = yBegin; y < yEnd; y++) {
+		float* row = accumulation + y * stride;
+		double dy = std::min(static_cast<double>(y + 1), P1.y()) - std::max(static_cast<double>(y), P0.y());
+		double xNext = x + dxdy * dy;
+		double d = dy * direction;
+		double x0 = std::min(x, xNext);
+		double x1 = std::max(x, xNext);
+		double x0Floor = floor(x0);
+		int x0i = static_cast<int>(x0Floor);
+		double x1Ceil = ceil(x1);
+		int x1i = static_cast<int>(x1Ceil);
+		if (x1i <= x0i + 1) {
+			//edge stays in one pixel of scanline, area right of it goes to next pixel
+			double xMiddle = 0.5 * (x + xNext) - x0Floor;
+			row[x0i] += static_cast<float>(d - d * xMiddle);
+			row[x0i + 1] += static_cast<float>(d * xMiddle);
+		}
+		else {
+			double s = 1 / (x1 - x0);
+			double x0Fraction = x0 - x0Floor;
+			double a0 = 0.5 * s * (1 - x0Fraction) * (1 - x0Fraction);
+			double x1Fraction = x1 - x1Ceil + 1;
+			double aLast = 0.5 * s * x1Fraction * x1Fraction;
+			row[x0i] += static_cast<float>(d * a0);
+			if (x1i == x0i + 2) {
+				row[x0i + 1] += static_cast<float>(d * (1 - a0 - aLast));
+			}
+			else {
+				double a1 = s * (1.5 - x0Fraction);
+				row[x0i + 1] += static_cast<float>(d * (a1 - a0));
+				for (int xi = x0i + 2; xi < x1i - 1; xi++) {
+					row[xi] += static_cast<float>(d * s);
+				}
+				double a2 = a1 + (x1i - x0i - 3) * s;
+				row[x1i - 1] += static_cast<float>(d * (1 - a2 - aLast));
+			}
+			row[x1i] += static_cast<float>(d * aLast);
+		}
+		x = xNext;
+	}
+}
+void Renderer::fillPolygonCoverage(const QVector<QPoint>& points, const QColor& color) {
+	//points are clipped to image, coverage is accumulated only in bounding box of polygon
+	int xMin = points[0].x(), xMax = points[0].x();
+	int yMin = points[0].y(), yMax = points[0].y();
+	for (const QPoint& point : points) {
+		xMin = std::min(xMin, point.x());
+		xMax = std::max(xMax, point.x());
+		yMin = std::min(yMin, point.y());
+		yMax = std::max(yMax, point.y());
+	}
+	int stride = xMax - xMin + 3;
+	int rows = yMax - yMin;
+	if (rows <= 0 || stride <= 3) {
+		return;
+	}
+	coverageBuffer.fill(0.0f, stride * rows);
+	QPointF origin = QPointF(xMin, yMin);
+	QPoint start = points.last();
+	for (const QPoint& end : points) {
+		accumulateCoverageEdge(coverageBuffer.data(), stride, rows, QPointF(start) - origin, QPointF(end) - origin);
+		start = end;
+	}
+	QRgb rgb = color.rgba();
+	bool evenOdd = polygonFillRule == 0;
+	for (int row = 0; row < rows; row++) {
+		int y = yMin + row;
+		if (y < 0 || y >= img->height()) {
+			continue;
+		}
+		const float* accumulation = coverageBuffer.constData() + row * stride;
+		float sum = 0;
+		//fully covered pixels are collected into spans and filled at once
+		int spanStart = -1;
+		int xEnd = std::min(xMin + stride, img->width());
+		for (int x = std::max(xMin, 0); x < xEnd; x++) {
+			sum += accumulation[x - xMin];
+			//same fill rule as scanline fill, even-odd folds winding so that every second crossing leaves polygon
+			float winding = std::abs(sum);
+			if (evenOdd) {
+				winding = fmodf(winding, 2.0f);
+				winding = winding > 1 ? 2 - winding : winding;
+			}
+			int coverage = std::min(static_cast<int>(winding * 256 + 0.5f), 256);
+			if (coverage == 256) {
+				if (spanStart < 0) {
+					spanStart = x;
+				}
+				continue;
+			}
+			if (spanStart >= 0) {
+				plotSpan(y, spanStart, x - 1, rgb);
+				spanStart = -1;
+			}
+			plotPixelCoverage(x, y, rgb, coverage);
+		}
+		if (spanStart >= 0) {
+			plotSpan(y, spanStart, xEnd - 1, rgb);
+		}
+	}
+	requestUpdate();
+}
+void Renderer::drawPolygon(const QVector<QPoint>& polygon, const QColor& color, int algType, int fillingAlgType) {
+	if (polygon.length() <= 2) {
+		return;
+	}
+	QRect boundingBox = QRect(polygon[0], polygon[0]);
+	for (const QPoint& point : polygon) {
+		boundingBox |= QRect(point, point);
+	}
+	if (!boundingBox.intersects(img->rect())) {
+		//qDebug() << "drawing polygon : none";
+		return;
+	}
+	//polygon inside guard band is drawn as it is and rasterizers clamp it to image,
+	//otherwise clipped polygon lives in clip buffer of widget, no copy is made
+	//coverage accumulation works in bounding box of polygon, so anti-aliased polygon is always clipped
+	bool clippingNeeded = !isInsideGuardBand(boundingBox) || (antialiasing && fillingAlgType == 1);
+	const QVector<QPoint>& points = clippingNeeded ? sutherlandHodgman(polygon) : polygon;
+	if (points.isEmpty() || points.length() <= 2) {
+		//qDebug() << "drawing polygon : none";
+		return;
+	}
+	if (points.length() == 3 && (points[0] == points[1] || points[1] == points[2] || points[2] == points[0])) {
+		return;
+	}
+	bool isHorizontalLine = std::all_of(points.begin(), points.end(), [&](const QPoint& point) {
+		return point.y() == points[0].y();
+		});
+	bool isVerticalLine = std::all_of(points.begin(), points.end(), [&](const QPoint& point) {
+		return point.x() == points[0].x();
+		});
+	if (isHorizontalLine || isVerticalLine) {
+		//qDebug() << "drawing polygon : none";
+		return;
+	}
+	//qDebug() << "drawing polygon : " << points;
+	croppedBySutherlandHodgman = true;
+	if (fillingAlgType == 0) {
+		for (int i = 0; i < points.length(); i++) {
+			if (i < points.length() - 1) {
+				drawLine(points[i], points[i + 1], color, algType);
+			}
+			else {
+				drawLine(points[i], points[0], color, algType);
+			}
+		}
+	}
+	else if (antialiasing && fillingAlgType == 1) {
+		fillPolygonCoverage(points, color);
+	}
+	else if (points.length() == 3) {
+		fillTriangleSetup(points, color, fillingAlgType);
+	}
+	else {
+		scanLinePolygon(points, color);
+	}
+	for (const QPoint& point : points) {
+		drawCircle(point, 1, Qt::red);
+	}
+	croppedBySutherlandHodgman = false;
+}
+void Renderer::scanLinePolygon(const QVector<QPoint>& points, const QColor& color) {
+	//Edge list, x is kept in 16.16 fixed point and sampled in centers of pixels,
+	//edge covers scanlines yTop .. yBottom - 1, winding tells if it goes down or up
+	QVector<ScanlineEdge>& edges = scanlineEdges;
+	edges.resize(0);
+	int yMin = INT_MAX;
+	int yMax = INT_MIN;
+	QPoint start = points.last();
+	for (const QPoint& end : points) {
+		QPoint top = start;
+		QPoint bottom = end;
+		int winding = 1;
+		if (top.y() > bottom.y()) {							// usporiadanie hrany z hora dole
+			std::swap(top, bottom);
+			winding = -1;
+		}
+		if (top.y() != bottom.y()) {						// vynechanie horizontalnych hran
+			ScanlineEdge edge;
+			edge.yTop = top.y();
+			edge.yBottom = bottom.y();
+			edge.dx = (static_cast<qint64>(bottom.x() - top.x()) << 16) / (bottom.y() - top.y());
+			edge.x = (static_cast<qint64>(top.x()) << 16) + edge.dx / 2;
+			edge.winding = winding;
+			edges.append(edge);
+			yMin = std::min(yMin, edge.yTop);
+			yMax = std::max(yMax, edge.yBottom);
+		}
+		start = end;
+	}
+	//scanlines are clamped to image
+	int yBegin = std::max(yMin, 0);
+	int yEnd = std::min(yMax, img->height());
+	if (edges.isEmpty() || yBegin >= yEnd) {
+		return;
+	}
+	//Bucketed edge list, counting sort by first visible scanline into one flat array,
+	//edges of bucket i are bucketedEdges[edgeBucketStart[i] .. edgeBucketStart[i + 1] - 1]
+	int rows = yEnd - yBegin;
+	edgeBucketStart.fill(0, rows + 1);
+	for (const ScanlineEdge& edge : edges) {
+		if (edge.yTop < yEnd && edge.yBottom > yBegin) {
+			edgeBucketStart[std::max(edge.yTop, yBegin) - yBegin + 1]++;
+		}
+	}
+	for (int i = 0; i < rows; i++) {
+		edgeBucketStart[i + 1] += edgeBucketStart[i];
+	}
+	bucketedEdges.resize(edgeBucketStart[rows]);
+	edgeBucketFill.resize(rows);
+	std::copy(edgeBucketStart.begin(), edgeBucketStart.begin() + rows, edgeBucketFill.begin());
+	for (const ScanlineEdge& edge : edges) {
+		if (edge.yTop < yEnd && edge.yBottom > yBegin) {
+			bucketedEdges[edgeBucketFill[std::max(edge.yTop, yBegin) - yBegin]++] = edge;
+		}
+	}
+
+	QRgb rgb = color.rgba();
+	int width = img->width();
+	int fillRule = polygonFillRule;
+	//Every band of scanlines has its own active edge table, bands write disjoint rows so they run in parallel
+	auto fillBand = [&](int bandBegin, int bandEnd, int band) {
+		QVector<ScanlineEdge>& eActive = bandActiveEdges[band];
+		eActive.resize(0);
+		//edges which started above first scanline of band
+		for (int i = 0; i < edgeBucketStart[bandBegin - yBegin]; i++) {
+			ScanlineEdge edge = bucketedEdges[i];
+			if (edge.yBottom > bandBegin) {
+				edge.x += edge.dx * (bandBegin - edge.yTop);
+				eActive.append(edge);
+			}
+		}
+		for (int y = bandBegin; y < bandEnd; y++) {
+			int activeCount = 0;
+			for (int k = 0; k < eActive.length(); k++) {
+				if (eActive[k].yBottom > y) {
+					eActive[activeCount++] = eActive[k];
+				}
+			}
+			eActive.resize(activeCount);
+			for (int i = edgeBucketStart[y - yBegin]; i < edgeBucketStart[y - yBegin + 1]; i++) {
+				ScanlineEdge edge = bucketedEdges[i];
+				edge.x += edge.dx * (y - edge.yTop);
+				eActive.append(edge);
+			}
+			//active edges stay almost sorted between scanlines, so insertion sort is close to linear,
+			//crossing edges of self-intersecting polygon just swap places
+			for (int k = 1; k < eActive.length(); k++) {
+				ScanlineEdge edge = eActive[k];
+				int l = k - 1;
+				while (l >= 0 && eActive[l].x > edge.x) {
+					eActive[l + 1] = eActive[l];
+					l--;
+				}
+				eActive[l + 1] = edge;
+			}
+			//pixel is filled when its center lies inside by fill rule, 0 - even-odd, 1 - non-zero
+			int winding = 0;
+			for (int k = 0; k + 1 < eActive.length(); k++) {
+				winding += fillRule == 0 ? 1 : eActive[k].winding;
+				bool inside = fillRule == 0 ? (winding & 1) != 0 : winding != 0;
+				if (inside) {
+					int x0 = static_cast<int>((eActive[k].x + 0x7FFF) >> 16);
+					int x1 = static_cast<int>((eActive[k + 1].x + 0x7FFF) >> 16) - 1;
+					plotSpan(y, std::max(x0, 0), std::min(x1, width - 1), rgb);
+				}
+			}
+			for (ScanlineEdge& edge : eActive) {
+				edge.x += edge.dx;
+			}
+		}
+	};
+	//small polygons are not worth starting threads
+	int bandCount = 1;
+	if (static_cast<qint64>(rows) * width >= 256 * 1024 || edges.length() >= 4096) {
+		bandCount = std::min(workers.threadCount(), std::max(rows / 16, 1));
+	}
+	if (bandActiveEdges.length() < bandCount) {
+		bandActiveEdges.resize(bandCount);
+	}
+	workers.parallelFor(yBegin, yEnd, bandCount, fillBand);
+	requestUpdate();
+}
+void Renderer::fillTriangleSetup(const QVector<QPoint>& points, const QColor& color,int fillAlgType) {
+	std::array<QPoint, 3> T = { points[0], points[1], points[2] };
+	std::sort(T.begin(), T.end(), [](QPoint point1, QPoint point2) {
+		if (point1.y() < point2.y() || point1.y() == point2.y() && point1.x() < point2.x()) {
+			return TRUE;
+		}
+		else {
+			return FALSE;
+		}
+		});
+	if (T[0].y() == T[1].y() || T[1].y() == T[2].y()) {
+		fillTriangle(T, points, color, fillAlgType);
+		return;
+	}
+	double m = static_cast<double>(T[2].y() - T[0].y()) / (T[2].x() - T[0].x());
+	QPoint P = QPoint((T[1].y() - T[0].y()) / m + T[0].x(), T[1].y());
+	if (T[1].x() < P.x()) {
+		fillTriangle({ T[0],T[1],P }, points,color,fillAlgType);
+		fillTriangle({ T[1], P, T[2] }, points, color,fillAlgType);
+	}
+	else {
+		fillTriangle({ T[0], P, T[1] }, points, color,fillAlgType);
+		fillTriangle({ P,T[1],T[2] }, points, color,fillAlgType);
+	}
+}
+void Renderer::fillTriangle(const std::array<QPoint, 3>& currentPoints, const QVector<QPoint>& oldPoints, QColor color ,int fillAlgType) {
+	struct Edge {
+		QPoint start;
+		QPoint end;
+		double m = 0;
+	};
+	static const std::array<QColor, 3> colors = { QColor(Qt::red), QColor(Qt::blue), QColor(Qt::green) };
+	Edge edges[3];
+	int edgeCount = 0;
+	QPoint start = currentPoints.back();
+	for (int i = 0; i < 3; i++) {
+		QPoint end = currentPoints[i];
+		if (start.y() > end.y()) {
+			std::swap(start, end);
+		}
+		if (start.y() != end.y()) {
+			Edge edge;
+			edge.start = start;
+			edge.end = end;
+			edge.m = static_cast<double>(end.y() - start.y()) / (end.x() - start.x());
+			edges[edgeCount++] = edge;
+		}
+
+		start = currentPoints[i];
+	}
+	if (edges[0].end.x() != edges[1].end.x()) {
+		std::sort(edges, edges + edgeCount, [](const Edge& edge1, const Edge& edge2) {
+			return edge1.end.x() < edge2.end.x();
+			});
+	}
+	int ymin = edges[0].start.y();
+	int ymax = std::min(edges[0].end.y(), img->height());
+	double x1 = edges[0].start.x();
+	double x2 = edges[1].start.x();
+	//rows above image are skipped at once
+	if (ymin < 0) {
+		x1 += -ymin / edges[0].m;
+		x2 += -ymin / edges[1].m;
+		ymin = 0;
+	}
+	for (int y = ymin; y < ymax; y++) {
+		if (x1 != x2) {
+			//span is clamped to image, no per pixel test is needed
+			int xBegin = std::max(static_cast<int>(x1), 0);
+			int xEnd = std::min(static_cast<int>(x2), img->width() - 1);
+			if (fillAlgType == 2 || fillAlgType == 3) {
+				for (int x = xBegin; x <= xEnd; x++) {
+					if (fillAlgType == 2) {
+						color = fillTriangleNearestNeighbour(oldPoints, QPoint(x, y), colors);
+					}
+					else {
+						color = fillTriangleBaricentric(oldPoints, QPoint(x, y), colors);
+					}
+					plotPixel(x, y, color.rgba());
+				}
+			}
+			else {
+				plotSpan(y, xBegin, xEnd, color.rgba());
+			}
+		}
+		x1 += 1 / edges[0].m;
+		x2 += 1 / edges[1].m;
+	}
+	requestUpdate();
+}
+QColor Renderer::fillTriangleNearestNeighbour(const QVector<QPoint>& points, QPoint currentPoint, const std::array<QColor, 3>& colors) {
+	double distance[3] = { 0, 0, 0 };
+	for (int i = 0; i < points.length(); i++) {
+		distance[i] = sqrt(pow(currentPoint.x() - points[i].x(), 2) + pow(currentPoint.y() - points[i].y(), 2));
+	}
+	if (distance[0] <= distance[1] && distance[0] <= distance[2]) {
+		return colors[0];
+	}
+	else if (distance[1] <= distance[2] && distance[1] <= distance[0]) {
+		return colors[1];
+	}
+	else if (distance[2] <= distance[1] && distance[2] <= distance[0]) {
+		return colors[2];
+	}
+	return Qt::white;
+}
+QColor Renderer::fillTriangleBaricentric(const QVector<QPoint>& points, QPoint currentPoint, const std::array<QColor, 3>& colors) {
+	QPoint P = currentPoint;
+	const QVector<QPoint>& T = points;
+	double lambda[3];
+	lambda[0] = abs((T[1].x() - P.x()) * (T[2].y() - P.y()) - (T[1].y() - P.y()) * (T[2].x() - P.x()));
+	lambda[0] /= abs(static_cast<double>(T[1].x() - T[0].x()) * (T[2].y() - T[0].y()) - (T[1].y() - T[0].y()) * (T[2].x() - T[0].x()));
+
+	lambda[1] = abs((T[0].x() - P.x()) * (T[2].y() - P.y()) - (T[0].y() - P.y()) * (T[2].x() - P.x()));
+	lambda[1] /= abs(static_cast<double>(T[1].x() - T[0].x()) * (T[2].y() - T[0].y()) - (T[1].y() - T[0].y()) * (T[2].x() - T[0].x()));
+
+	lambda[2] = 1 - lambda[0] - lambda[1];
+
+	double red = 0, green = 0, blue = 0;
+	for (int i = 0; i < 3; i++) {
+		red += lambda[i] * colors[i].red();
+		green += lambda[i] * colors[i].green();
+		blue += lambda[i] * colors[i].blue();
+	}
+	return QColor(static_cast<int> (red), static_cast<int> (green), static_cast<int> (blue), 255);
+}
+void Renderer::drawCurve(const QVector<QPair<QPoint, QPoint>>& points, const QColor& color, int algType) {
+	if (algType == 0) {
+		drawCurveHermint(points, color);
+	}
+	else {
+		//control points are collected into reused buffer, capacity is kept between redraws
+		curveControlPoints.resize(0);
+		for (int i = 0; i < points.length(); i++) {
+			curveControlPoints.append(points[i].first);
+		}
+		if (algType == 1) {
+			drawCurveCasteljau(curveControlPoints, color);
+		}
+		else {
+			drawCurveCoons(curveControlPoints, color);
+		}
+	}
+}
+void Renderer::drawCurveHermint(const QVector<QPair<QPoint, QPoint>>& points, const QColor& color) {
+	int n = points.length();
+	const QVector<QPair<QPoint, QPoint>>& P = points;
+	curvePolyline.resize(0);
+	if (n > 0) {
+		curvePolyline.append(P[0].first);
+	}
+	for (int i = 1; i < n; i++) {
+		flattenHermiteSegment(P[i - 1].first, P[i - 1].second - P[i - 1].first, P[i].first, P[i].second - P[i].first, curveTolerance, curvePolyline);
+	}
+	renderBatch.clear();
+	renderBatch.addPolyline(curvePolyline, color);
+	recordCurveControlPoints(P, 0, 0, renderBatch);
+	submitBatch(renderBatch);
+}
+void Renderer::drawCurveCasteljau(const QVector<QPoint>& points, const QColor& color) {
+	int n = points.length();
+	if (n == 0) {
+		return;
+	}
+	curvePolyline.resize(0);
+	curvePolyline.append(points[0]);
+	flattenBezier(points, curveTolerance, curveSubdivisionBuffer, curvePolyline);
+	renderBatch.clear();
+	renderBatch.addPolyline(curvePolyline, color);
+	for (int i = 0; i < n; i++) {
+		renderBatch.addCircle(points[i], 2, Qt::red);
+	}
+	submitBatch(renderBatch);
+}
+void Renderer::drawCurveCoons(const QVector<QPoint>& points, const QColor& color) {
+	const QVector<QPoint>& P = points;
+	int n = points.length();
+	curvePolyline.resize(0);
+	if (n > 3) {
+		//start of first segment, every other segment starts where previous one ended
+		curvePolyline.append(QPointF(P[0] + 4 * P[1] + P[2]) / 6);
+	}
+	for (int i = 3; i < n; i++) {
+		flattenCoonsSegment(P[i - 3], P[i - 2], P[i - 1], P[i], curveTolerance, curvePolyline);
+	}
+	renderBatch.clear();
+	renderBatch.addPolyline(curvePolyline, color);
+	for (const QPoint& point : points) {
+		renderBatch.addCircle(point, 2, Qt::red);
+	}
+	submitBatch(renderBatch);
+}
+
+void Renderer::recordCurveControlPoints(const QVector<QPair<QPoint, QPoint>>& points, int algType, int layer, RenderBatch& batch) {
+	for (const QPair<QPoint, QPoint>& pair : points) {
+		if (algType == 0) {
+			batch.addLine(pair.first, pair.second, Qt::red, layer);
+			batch.addCircle(pair.second, 2, Qt::red, layer);
+		}
+		batch.addCircle(pair.first, 2, Qt::red, layer);
+	}
+}
+void Renderer::recordCurveObject(const Object2D& object, RenderBatch& batch) {
+	const QVector<QPair<QPoint, QPoint>>& P = object.curve_points;
+	int segmentCount = object.curveSegmentCount();
+	//whole cache is dropped when number of segments or tolerance changed
+	if (object.curve_segment_valid.length() != segmentCount || object.curve_cache_tolerance != curveTolerance) {
+		object.curve_segment_polylines.resize(segmentCount);
+		object.curve_segment_valid.fill(false, segmentCount);
+		object.curve_cache_tolerance = curveTolerance;
+	}
+	for (int i = 0; i < segmentCount; i++) {
+		if (!object.curve_segment_valid[i]) {
+			QVector<QPointF>& polyline = object.curve_segment_polylines[i];
+			polyline.resize(0);
+			if (object.curve_type == 0) {
+				polyline.append(P[i].first);
+				flattenHermiteSegment(P[i].first, P[i].second - P[i].first, P[i + 1].first, P[i + 1].second - P[i + 1].first, curveTolerance, polyline);
+			}
+			else if (object.curve_type == 1) {
+				curveControlPoints.resize(0);
+				for (const QPair<QPoint, QPoint>& pair : P) {
+					curveControlPoints.append(pair.first);
+				}
+				polyline.append(P[0].first);
+				flattenBezier(curveControlPoints, curveTolerance, curveSubdivisionBuffer, polyline);
+			}
+			else {
+				polyline.append(QPointF(P[i].first + 4 * P[i + 1].first + P[i + 2].first) / 6);
+				flattenCoonsSegment(P[i].first, P[i + 1].first, P[i + 2].first, P[i + 3].first, curveTolerance, polyline);
+			}
+			object.curve_segment_valid[i] = true;
+		}
+		batch.addPolyline(object.curve_segment_polylines[i], object.color_outline, object.layer_height);
+	}
+	recordCurveControlPoints(P, object.curve_type, object.layer_height, batch);
+}
+
+void Renderer::drawObjects2D(const QMap<QString,Object2D>& objects) {
+	//whole scene is one batch, sorting by layer replaces layer Z-buffer
+	renderBatch.clear();
+	for (const Object2D& object : objects) {
+		if (object.type == "line") {
+			renderBatch.addLine(object.points[0], object.points[1], object.color_outline, object.layer_height);
+		}
+		else if (object.type == "circle") {
+			QPoint radiusVector = object.points[1] - object.points[0];
+			int r = static_cast<int>(sqrt(pow(radiusVector.x(), 2) + pow(radiusVector.y(), 2)));
+			renderBatch.addCircle(object.points[0], r, object.color_outline, object.layer_height);
+		}
+		else if (object.type == "ellipse") {
+			//second point is corner of box around ellipse, ellipse is filled unless filling algorithm is none
+			QPoint radiusVector = object.points[1] - object.points[0];
+			bool filled = object.filling_alg != 0;
+			renderBatch.addEllipse(object.points[0], abs(radiusVector.x()), abs(radiusVector.y()), filled ? object.color_filling : object.color_outline, object.layer_height, filled);
+		}
+		else if (object.type == "polygon") {
+			renderBatch.addPolygon(object.points, object.color_filling, object.layer_height, 1, object.filling_alg);
+		}
+		else if (object.type == "curve") {
+			recordCurveObject(object, renderBatch);
+		}
+	}
+	submitBatch(renderBatch);
+}
+void Renderer::submitBatch(const RenderBatch& batch) {
+	const QVector<RenderCommand>& commands = batch.getCommands();
+	//recording order is kept inside layer, higher layer is drawn later and stays on top.
+	//ties are broken by index instead of stable sort, which allocates temporary buffer on every call
+	batchOrder.resize(commands.length());
+	for (int i = 0; i < commands.length(); i++) {
+		batchOrder[i] = i;
+	}
+	std::sort(batchOrder.begin(), batchOrder.end(), [&](int i, int j) {
+		return commands[i].layer < commands[j].layer || (commands[i].layer == commands[j].layer && i < j);
+		});
+	QRect imageRect = img->rect();
+	QRect band = guardBand();
+	QRect dirtyRegion;
+	batchSubmitting = true;
+	for (int index : batchOrder) {
+		const RenderCommand& command = commands[index];
+		//bulk clipping, commands outside image are dropped and commands inside guard band are never clipped
+		if (!command.boundingBox.intersects(imageRect)) {
+			continue;
+		}
+		bool clippingNeeded = !band.contains(command.boundingBox);
+		const QPoint* points = batch.commandPoints(command);
+		if (command.type == RenderCommandType::Polyline) {
+			croppedBySutherlandHodgman = !clippingNeeded;
+			for (int i = 1; i < command.pointCount; i++) {
+				drawLine(points[i - 1], points[i], command.color, command.algType);
+			}
+			if (command.closed && command.pointCount > 2) {
+				drawLine(points[command.pointCount - 1], points[0], command.color, command.algType);
+			}
+			croppedBySutherlandHodgman = false;
+		}
+		else if (command.type == RenderCommandType::Circle) {
+			if (antialiasing && !command.closed) {
+				drawCircleWu(points[0], command.radius, command.color);
+			}
+			else {
+				drawCircle(points[0], command.radius, command.color, command.closed);
+			}
+		}
+		else if (command.type == RenderCommandType::Ellipse) {
+			drawEllipse(points[0], command.radius, command.radiusY, command.color, command.closed);
+		}
+		else {
+			batchPolygon.resize(0);
+			for (int i = 0; i < command.pointCount; i++) {
+				batchPolygon.append(points[i]);
+			}
+			drawPolygon(batchPolygon, command.color, command.algType, command.fillingAlgType);
+		}
+		//margin covers anti-aliased fringe and vertex markers of polygons
+		dirtyRegion |= command.boundingBox.adjusted(-2, -2, 2, 2) & imageRect;
+	}
+	batchSubmitting = false;
+	if (!dirtyRegion.isEmpty()) {
+		imageChanged(dirtyRegion);
+	}
+}
+//Level of detail
+void Renderer::stopLevelOfDetail() {
+	lodCancel = true;
+	if (lodThread.joinable()) {
+		lodThread.join();
+	}
+	lodCancel = false;
+	for (Object_H_edge& level : lodLevels) {
+		level.release();
+	}
+	lodLevels.clear();
+	for (Object_H_edge& level : lodPending) {
+		level.release();
+	}
+	lodPending.clear();
+	lodPendingReady = false;
+}
+void Renderer::setCurrentObject(Object_H_edge&& object) {
+	stopLevelOfDetail();
+	scene.clear();
+	bspTrees.clear();
+	currentObject = std::move(object);
+	invalidateProjection();
+	currentObjectRadius = 0;
+	if (currentObject.vertices.isEmpty()) {
+		return;
+	}
+	Vertex minimum = *currentObject.vertices[0];
+	Vertex maximum = minimum;
+	for (const Vertex* vertex : currentObject.vertices) {
+		minimum = Vertex(std::min(minimum.x, vertex->x), std::min(minimum.y, vertex->y), std::min(minimum.z, vertex->z));
+		maximum = Vertex(std::max(maximum.x, vertex->x), std::max(maximum.y, vertex->y), std::max(maximum.z, vertex->z));
+	}
+	currentObjectCenter = Vertex((minimum.x + maximum.x) / 2, (minimum.y + maximum.y) / 2, (minimum.z + maximum.z) / 2);
+	Vertex halfDiagonal = maximum - currentObjectCenter;
+	currentObjectRadius = sqrt(halfDiagonal * halfDiagonal);
+	//small objects are drawn fast enough in full resolution
+	if (currentObject.triangle_indices.length() / 3 < 4096) {
+		return;
+	}
+	//simplification works on copy of triangles, full object is drawn meanwhile
+	SimplificationInput input = simplificationInput(currentObject);
+	lodThread = std::thread([this, input = std::move(input)]() {
+		QVector<Object_H_edge> levels = simplifyMesh(input, { 0.5, 0.25, 0.1 }, &lodCancel);
+		std::lock_guard<std::mutex> lock(lodMutex);
+		lodPending = std::move(levels);
+		lodPendingReady = true;
+	});
+}
+VertexCacheReport Renderer::optimizeCurrentObject() {
+	VertexCacheReport report = optimizeVertexCache(currentObject);
+	//vertices moved, cached projection and BSP tree belong to old order
+	invalidateProjection();
+	bspTrees.remove(&currentObject);
+	return report;
+}
+const Object_H_edge& Renderer::selectLevelOfDetail(const Object_H_edge& object, int projectionType) {
+	if (&object != &currentObject || !levelOfDetail) {
+		return object;
+	}
+	//finished levels are taken over from background thread, drawing never waits for it
+	{
+		std::unique_lock<std::mutex> lock(lodMutex, std::try_to_lock);
+		if (lock.owns_lock() && lodPendingReady) {
+			lodLevels = std::move(lodPending);
+			lodPending = QVector<Object_H_edge>();
+			lodPendingReady = false;
+		}
+	}
+	if (lodLevels.isEmpty()) {
+		return object;
+	}
+	//projected radius of bounding sphere, perspective enlarges object closer to camera
+	double radius = currentObjectRadius;
+	if (projectionType == 1) {
+		double distance = camera.position.z - currentObjectCenter * projectionPlane.basisVectorN - currentObjectRadius;
+		if (distance <= 0) {
+			return object;
+		}
+		radius *= camera.position.z / distance;
+	}
+	//front half of surface covers projected disc, about four pixels per visible triangle are enough,
+	//during interaction much coarser level is accepted
+	double neededTriangles = M_PI * radius * radius / 2;
+	if (interactive) {
+		neededTriangles /= 8;
+	}
+	for (int i = lodLevels.length() - 1; i >= 0; i--) {
+		if (lodLevels[i].faces.length() >= neededTriangles) {
+			return lodLevels[i];
+		}
+	}
+	return object;
+}
+
+//3D draw functions
+void Renderer::drawObject(const Object_H_edge& requestedObject, int projectionType, int representationType,int fillingAlgType, const LightSettings* ls) {
+	profiler.beginFrame();
+	//representations 2 and 3 are surface drawn without depth buffer, back to front by painter's algorithm or by BSP tree
+	surfaceVisibility = representationType >= 2 ? representationType - 1 : 0;
+	representationType = std::min(representationType, 1);
+	//current object is replaced by its simplified level when that is enough for its size on screen
+	const Object_H_edge& object = selectLevelOfDetail(requestedObject, projectionType);
+	//scene takes place of current object when it's loaded
+	if (&requestedObject == &currentObject && !scene.isEmpty()) {
+		drawScene(projectionType, representationType, fillingAlgType, ls);
+		profiler.endFrame();
+		requestUpdate();
+		return;
+	}
+	//copies of current object share its mesh
+	if (&requestedObject == &currentObject && !instances.isEmpty()) {
+		drawInstances(object, projectionType, representationType, fillingAlgType, ls);
+		profiler.endFrame();
+		requestUpdate();
+		return;
+	}
+	//Wireframe-Model, object itself isn't transformed, edges are drawn against cached projected vertices
+	if (representationType == 0) {
+		drawWireframe(object, projectionType);
+		profiler.endFrame();
+		return;
+	}
+	//Storing old Vertices in reused vector , transforming object to projection coordinates
+	{
+		ProfileScope scope(profiler, ProfileStage::Transform);
+		perspectiveCoordSystemTransformation(object, projectionType, savedVertices);
+	}
+	//Surface-Representation
+	if (representationType == 1) {
+		// resetting arrays of depth of image and color for Z-buffer algorithm
+		beginSurfaceFrame();
+		drawSurface(object, projectionType, fillingAlgType, ls);
+		profileCoveredPixels();
+	}
+
+
+	//updating old Vertices
+	{
+		ProfileScope scope(profiler, ProfileStage::Transform);
+		for (int i = 0; i < object.vertices.length(); i++) {
+			*object.vertices[i] = savedVertices[i];
+		}
+	}
+	profiler.endFrame();
+	requestUpdate();
+}
+void Renderer::drawInstances(const Object_H_edge& object, int projectionType, int representationType, int fillingAlgType, const LightSettings* ls) {
+	ProfileFrame& frame = profiler.frame();
+	const int vertexCount = object.vertices.length();
+	//instances with same rotation and scale are drawn one after another, they share rotated vertices in view coordinates,
+	//only translation and perspective division are done per instance
+	instanceTransforms.resize(0);
+	instanceOrder.resize(instances.length());
+	for (int i = 0; i < instances.length(); i++) {
+		instanceTransforms.append(InstanceTransform(instances[i]));
+		instanceOrder[i] = i;
+	}
+	//ties are broken by index instead of stable sort, which allocates temporary buffer on every call
+	std::sort(instanceOrder.begin(), instanceOrder.end(), [this](int i, int j) {
+		return instances[i].orientationLess(instances[j]) || (!instances[j].orientationLess(instances[i]) && i < j);
+	});
+	//without depth buffer copies are drawn back to front, copies of same orientation share vertices only when they follow each other
+	if (representationType == 1 && surfaceVisibility != 0) {
+		const Vertex& N = projectionPlane.basisVectorN;
+		instanceDepths.resize(instances.length());
+		for (int i = 0; i < instances.length(); i++) {
+			instanceDepths[i] = instanceTransforms[i].apply(currentObjectCenter) * N;
+		}
+		//position in orientation order breaks ties of depth, as stable sort kept it
+		instanceRanks.resize(instances.length());
+		for (int n = 0; n < instanceOrder.length(); n++) {
+			instanceRanks[instanceOrder[n]] = n;
+		}
+		std::sort(instanceOrder.begin(), instanceOrder.end(), [this](int i, int j) {
+			return instanceDepths[i] < instanceDepths[j] || (instanceDepths[i] == instanceDepths[j] && instanceRanks[i] < instanceRanks[j]);
+		});
+	}
+	{
+		ProfileScope scope(profiler, ProfileStage::Transform);
+		savedVertices.resize(vertexCount);
+		for (int i = 0; i < vertexCount; i++) {
+			savedVertices[i] = *object.vertices[i];
+		}
+	}
+	if (representationType == 1) {
+		beginSurfaceFrame();
+	}
+	//hidden lines of wireframe are removed against faces of all copies, depth of every copy is drawn before lines of any of them
+	const bool sharedWireDepth = representationType == 0 && hiddenLineRemoval;
+	if (sharedWireDepth) {
+		resetZBuffer();
+	}
+	for (int pass = 0; pass < (sharedWireDepth ? 2 : 1); pass++) {
+		wirePass = !sharedWireDepth ? WirePass::Single : (pass == 0 ? WirePass::Depth : WirePass::Lines);
+		//instance whose orientation view vertices were computed for
+		int viewVerticesOf = -1;
+		for (int n = 0; n < instanceOrder.length(); n++) {
+			const int i = instanceOrder[n];
+			const InstanceTransform& transform = instanceTransforms[i];
+			if (isSphereOutsideImage(transform.apply(currentObjectCenter), currentObjectRadius * transform.scale, projectionType)) {
+				//culled copy is counted once when wireframe takes two passes
+				if (pass == 0) {
+					frame.trianglesSubmitted += object.triangle_indices.length() / 3;
+				}
+				continue;
+			}
+			if (representationType == 1 && occlusionCulling && isSphereOccluded(transform.apply(currentObjectCenter), currentObjectRadius * transform.scale, projectionType)) {
+				frame.trianglesSubmitted += object.triangle_indices.length() / 3;
+				frame.trianglesOccluded += object.triangle_indices.length() / 3;
+				continue;
+			}
+			if (viewVerticesOf < 0 || !instances[i].sameOrientation(instances[viewVerticesOf])) {
+				viewVerticesOf = i;
+				computeViewVertices(transform);
+			}
+			drawViewVertices(object, transform, instances[i].color, projectionType, representationType, fillingAlgType, ls);
+		}
+	}
+	wirePass = WirePass::Single;
+	if (representationType == 1) {
+		profileCoveredPixels();
+	}
+	//updating old Vertices
+	{
+		ProfileScope scope(profiler, ProfileStage::Transform);
+		for (int i = 0; i < vertexCount; i++) {
+			*object.vertices[i] = savedVertices[i];
+		}
+	}
+}
+int Renderer::pickSceneObject(const QPoint& position, int projectionType) {
+	int picked = -1;
+	double pickedDepth = -DBL_MAX;
+	for (int i = 0; i < scene.objectCount(); i++) {
+		double xMin, xMax, yMin, yMax, zMax;
+		if (!sphereScreenBounds(scene.objectCenter(i), scene.objectRadius(i), projectionType, xMin, xMax, yMin, yMax, zMax)) {
+			continue;
+		}
+		if (position.x() >= xMin && position.x() <= xMax && position.y() >= yMin && position.y() <= yMax && zMax > pickedDepth) {
+			picked = i;
+			pickedDepth = zMax;
+		}
+	}
+	return picked;
+}
+void Renderer::moveSceneObject(int object, const QPoint& delta, int projectionType) {
+	//image x follows basis vector V and y follows U, perspective shrinks movement by distance of object's center
+	double scale = 1;
+	if (projectionType == 1) {
+		double depth = scene.objectCenter(object) * projectionPlane.basisVectorN;
+		scale = (camera.position.z - depth) / camera.position.z;
+	}
+	const Vertex& u = projectionPlane.basisVectorU;
+	const Vertex& v = projectionPlane.basisVectorV;
+	ObjectInstance placement = scene.placement(object);
+	placement.translation = Vertex(placement.translation.x + (delta.x() * v.x + delta.y() * u.x) * scale,
+		placement.translation.y + (delta.x() * v.y + delta.y() * u.y) * scale,
+		placement.translation.z + (delta.x() * v.z + delta.y() * u.z) * scale);
+	scene.setPlacement(object, placement);
+}
+void Renderer::drawScene(int projectionType, int representationType, int fillingAlgType, const LightSettings* ls) {
+	ProfileFrame& frame = profiler.frame();
+	//hierarchy is walked with image bounds, rejected node skips all objects under it
+	scene.buildHierarchy();
+	scene.collectVisible([this, projectionType](const Vertex& center, double radius) { return isSphereOutsideImage(center, radius, projectionType); }, sceneVisible);
+	//triangles of culled objects are counted as submitted here, drawn ones are counted by surface pass
+	int culledTriangles = 0;
+	for (int i = 0; i < scene.objectCount(); i++) {
+		culledTriangles += scene.objectMesh(i).triangle_indices.length() / 3;
+	}
+	//objects are drawn front to back, pixels of farther ones behind them fail Z-test before they are shaded,
+	//without depth buffer they are drawn back to front
+	sceneOrder.resize(0);
+	for (int object : sceneVisible) {
+		culledTriangles -= scene.objectMesh(object).triangle_indices.length() / 3;
+		double depth = scene.objectCenter(object) * projectionPlane.basisVectorN;
+		sceneOrder.append({ surfaceVisibility == 0 ? -depth : depth, object });
+	}
+	frame.trianglesSubmitted += culledTriangles;
+	std::sort(sceneOrder.begin(), sceneOrder.end());
+	if (representationType == 1) {
+		beginSurfaceFrame();
+	}
+	//hidden lines of wireframe are removed against faces of all objects, depth of every object is drawn before lines of any of them
+	const bool sharedWireDepth = representationType == 0 && hiddenLineRemoval;
+	if (sharedWireDepth) {
+		resetZBuffer();
+	}
+	for (int pass = 0; pass < (sharedWireDepth ? 2 : 1); pass++) {
+		wirePass = !sharedWireDepth ? WirePass::Single : (pass == 0 ? WirePass::Depth : WirePass::Lines);
+		for (const QPair<double, int>& entry : sceneOrder) {
+			const int i = entry.second;
+			Object_H_edge& object = scene.objectMesh(i);
+			//objects are tested against depth of closer ones drawn before them
+			if (representationType == 1 && occlusionCulling && isSphereOccluded(scene.objectCenter(i), scene.objectRadius(i), projectionType)) {
+				frame.trianglesSubmitted += object.triangle_indices.length() / 3;
+				frame.trianglesOccluded += object.triangle_indices.length() / 3;
+				continue;
+			}
+			InstanceTransform transform(scene.placement(i));
+			{
+				ProfileScope scope(profiler, ProfileStage::Transform);
+				savedVertices.resize(object.vertices.length());
+				for (int k = 0; k < object.vertices.length(); k++) {
+					savedVertices[k] = *object.vertices[k];
+				}
+			}
+			computeViewVertices(transform);
+			drawViewVertices(object, transform, scene.placement(i).color, projectionType, representationType, fillingAlgType, ls);
+			{
+				ProfileScope scope(profiler, ProfileStage::Transform);
+				for (int k = 0; k < object.vertices.length(); k++) {
+					*object.vertices[k] = savedVertices[k];
+				}
+			}
+		}
+	}
+	wirePass = WirePass::Single;
+	if (representationType == 1) {
+		profileCoveredPixels();
+	}
+}
+void Renderer::computeViewVertices(const InstanceTransform& transform) {
+	ProfileScope scope(profiler, ProfileStage::Transform);
+	//basis of view seen from rotated object, view coordinate of vertex is one dot product
+	std::array<Vertex, 3> basis;
+	for (int axis = 0; axis < 3; axis++) {
+		const Vertex& B = axis == 0 ? projectionPlane.basisVectorV : axis == 1 ? projectionPlane.basisVectorU : projectionPlane.basisVectorN;
+		basis[axis] = Vertex(B.x * transform.rows[0].x + B.y * transform.rows[1].x + B.z * transform.rows[2].x,
+			B.x * transform.rows[0].y + B.y * transform.rows[1].y + B.z * transform.rows[2].y,
+			B.x * transform.rows[0].z + B.y * transform.rows[1].z + B.z * transform.rows[2].z);
+	}
+	instanceViewVertices.resize(savedVertices.length());
+	for (int k = 0; k < savedVertices.length(); k++) {
+		instanceViewVertices[k] = Vertex(savedVertices[k] * basis[0], savedVertices[k] * basis[1], savedVertices[k] * basis[2]);
+	}
+}
+void Renderer::drawViewVertices(const Object_H_edge& object, const InstanceTransform& transform, const QColor& color, int projectionType, int representationType, int fillingAlgType, const LightSettings* ls) {
+	{
+		ProfileScope scope(profiler, ProfileStage::Transform);
+		const double correctionX = static_cast<double>(img->width()) / 2;
+		const double correctionY = static_cast<double>(img->height()) / 2;
+		const double cameraZ = camera.position.z;
+		const double offsetX = transform.translation * projectionPlane.basisVectorV;
+		const double offsetY = transform.translation * projectionPlane.basisVectorU;
+		const double offsetZ = transform.translation * projectionPlane.basisVectorN;
+		const int vertexCount = object.vertices.length();
+		//surface is filled from vertices of object transformed in place, wireframe reads separate projected vertices
+		if (representationType == 0) {
+			instanceVertices.resize(vertexCount);
+		}
+		for (int k = 0; k < vertexCount; k++) {
+			Vertex vertex(instanceViewVertices[k].x + offsetX, instanceViewVertices[k].y + offsetY, instanceViewVertices[k].z + offsetZ);
+			if (projectionType == 1) {
+				vertex.x = cameraZ * vertex.x / (cameraZ - vertex.z);
+				vertex.y = cameraZ * vertex.y / (cameraZ - vertex.z);
+			}
+			vertex.x += correctionX;
+			vertex.y += correctionY;
+			if (representationType == 0) {
+				instanceVertices[k] = vertex;
+			}
+			else {
+				object.vertices[k]->x = vertex.x;
+				object.vertices[k]->y = vertex.y;
+				object.vertices[k]->z = vertex.z;
+			}
+		}
+	}
+	if (representationType == 0) {
+		drawWireframeVertices(object, instanceVertices);
+	}
+	else {
+		drawSurface(object, projectionType, fillingAlgType, ls, &transform, color);
+	}
+}
+//Fills vertices of triangle from face, false when face isn't triangle
+static bool faceTriangle(const Face* face, SurfaceTriangle& triangle) {
+	int vertexCount = 0;
+	H_edge* edge = face->edge;
+	do {
+		if (vertexCount < 3) {
+			triangle.vertices[vertexCount] = edge->vert_origin;
+		}
+		vertexCount++;
+		edge = edge->edge_next;
+	} while (edge != face->edge);
+	return vertexCount == 3;
+}
+static bool isTriangleOutsideImage(const SurfaceTriangle& triangle, double width, double height) {
+	const Vertex& A = *triangle.vertices[0];
+	const Vertex& B = *triangle.vertices[1];
+	const Vertex& C = *triangle.vertices[2];
+	return std::max({ A.x, B.x, C.x }) < 0 || std::min({ A.x, B.x, C.x }) >= width ||
+		std::max({ A.y, B.y, C.y }) < 0 || std::min({ A.y, B.y, C.y }) >= height;
+}
+//Largest depth which fillObjectPolygon interpolates in pixels of box. Filler takes weights of vertices as absolute areas, so pixels which span ends
+//put outside of thin triangle get depth beyond its vertices, absolute value of area is largest in corner of box and bounds them too
+static double triangleNearestZ(const SurfaceTriangle& triangle, double x0, double x1, double y0, double y1) {
+	const Vertex& T0 = *triangle.vertices[0];
+	const Vertex& T1 = *triangle.vertices[1];
+	const Vertex& T2 = *triangle.vertices[2];
+	const double divider = abs((T1.x - T0.x) * (T2.y - T0.y) - (T1.y - T0.y) * (T2.x - T0.x));
+	if (divider == 0) {
+		return std::max({ T0.z, T1.z, T2.z });
+	}
+	double lambda0 = 0, lambda1 = 0;
+	for (double x : { x0, x1 }) {
+		for (double y : { y0, y1 }) {
+			lambda0 = std::max(lambda0, abs((T1.x - x) * (T2.y - y) - (T1.y - y) * (T2.x - x)) / divider);
+			lambda1 = std::max(lambda1, abs((T0.x - x) * (T2.y - y) - (T0.y - y) * (T2.x - x)) / divider);
+		}
+	}
+	return T2.z + lambda0 * std::max(T0.z - T2.z, 0.0) + lambda1 * std::max(T1.z - T2.z, 0.0);
+}
+void Renderer::drawSurface(const Object_H_edge& object, int projectionType, int fillingAlgType, const LightSettings* ls, const InstanceTransform* instance, const QColor& color) {
+	if (surfaceVisibility != 0) {
+		drawSurfaceOrdered(object, projectionType, fillingAlgType, ls, instance, color);
+		return;
+	}
+	ProfileFrame& frame = profiler.frame();
+	const double width = img->width();
+	const double height = img->height();
+	{
+		ProfileScope scope(profiler, ProfileStage::Cull);
+		visibleMeshlets.resize(0);
+		for (const Meshlet& meshlet : object.meshlets) {
+			frame.trianglesSubmitted += meshlet.triangleCount;
+			if (!isMeshletCulled(meshlet, projectionType, instance)) {
+				visibleMeshlets.append(&meshlet);
+			}
+		}
+	}
+	//clusters are drawn front to back by depth of their nearest points
+	if (frontToBack) {
+		ProfileScope scope(profiler, ProfileStage::Cull);
+		sortMeshletsFrontToBack(projectionType, instance);
+	}
+	//with depth prepass first pass writes only depth of all clusters and second one shades only pixels equal to it,
+	//so clusters and triangles behind final depth are rejected before shading
+	for (int passIndex = 0; passIndex < (depthPrepass ? 2 : 1); passIndex++) {
+		const SurfacePass pass = !depthPrepass ? SurfacePass::Single : passIndex == 0 ? SurfacePass::Depth : SurfacePass::AfterDepth;
+		const bool colorPass = pass != SurfacePass::Depth;
+		//visible clusters are handed to threads in batches, every thread prepares triangles of its own run of clusters,
+		//bands of rows then rasterize runs in cluster order, so image doesn't depend on number of threads
+		const int batchSize = 128;
+		const int threadCount = workers.threadCount();
+		for (int batchBegin = 0; batchBegin < visibleMeshlets.length(); batchBegin += batchSize) {
+			int batchEnd = std::min(batchBegin + batchSize, static_cast<int>(visibleMeshlets.length()));
+			//small batch isn't worth starting threads, every thread gets at least eight clusters
+			int chunkCount = std::max(1, std::min(threadCount, (batchEnd - batchBegin) / 8));
+			if (chunkTriangles.length() < chunkCount) {
+				chunkTriangles.resize(chunkCount);
+				chunkHalves.resize(chunkCount);
+				chunkBounds.resize(chunkCount);
+			}
+			chunkOccluded.fill(0, chunkCount);
+			{
+				ProfileScope scope(profiler, ProfileStage::Cull);
+				//only triangles are filled, triangles completely outside of image are rejected before shading,
+				//clusters behind depth drawn by earlier batches are rejected as whole
+				workers.parallelFor(batchBegin, batchEnd, chunkCount, [&](int first, int last, int chunk) {
+					QVector<SurfaceTriangle>& triangles = chunkTriangles[chunk];
+					triangles.resize(0);
+					for (int m = first; m < last; m++) {
+						const Meshlet& meshlet = *visibleMeshlets[m];
+						if (occlusionCulling && isSphereOccluded(instance != nullptr ? instance->apply(meshlet.center) : meshlet.center,
+							instance != nullptr ? meshlet.radius * instance->scale : meshlet.radius, projectionType)) {
+							chunkOccluded[chunk] += meshlet.triangleCount;
+							continue;
+						}
+						for (int i = meshlet.firstFace; i < meshlet.firstFace + meshlet.faceCount; i++) {
+							Face* face = object.faces[i];
+							SurfaceTriangle triangle;
+							if (!faceTriangle(face, triangle) || isTriangleOutsideImage(triangle, width, height)) {
+								continue;
+							}
+							const Vertex& A = *triangle.vertices[0];
+							const Vertex& B = *triangle.vertices[1];
+							const Vertex& C = *triangle.vertices[2];
+							//after depth prepass hierarchical depth is final, hidden triangle isn't shaded. Box is widened by pixel for spans
+							//rounded past triangle, its depth is bounded over whole box, so triangle taking pixel in single pass is never dropped
+							if (pass == SurfacePass::AfterDepth && occlusionCulling) {
+								double xMin = floor(std::min({ A.x, B.x, C.x })) - 1, xMax = floor(std::max({ A.x, B.x, C.x })) + 1;
+								double yMin = floor(std::min({ A.y, B.y, C.y })) - 1, yMax = floor(std::max({ A.y, B.y, C.y })) + 1;
+								if (isBoxOccluded(xMin, xMax, yMin, yMax, triangleNearestZ(triangle, xMin, xMax, yMin, yMax))) {
+									chunkOccluded[chunk]++;
+									continue;
+								}
+							}
+							triangle.colors[0] = color.isValid() ? color : object.colors.value(face);
+							triangles.append(triangle);
+						}
+					}
+				});
+			}
+			int batchTriangles = 0;
+			for (int chunk = 0; chunk < chunkCount; chunk++) {
+				batchTriangles += chunkTriangles[chunk].length();
+				if (colorPass) {
+					frame.trianglesOccluded += chunkOccluded[chunk];
+				}
+			}
+			if (colorPass) {
+				frame.trianglesDrawn += batchTriangles;
+			}
+			rasterizeChunks(chunkCount, ls, fillingAlgType, pass);
+		}
+	}
+}
+void Renderer::rasterizeChunks(int chunkCount, const LightSettings* ls, int fillingAlgType, SurfacePass pass) {
+	ProfileFrame& frame = profiler.frame();
+	const bool usingLightSettings = ls != nullptr;
+	const bool colorPass = pass != SurfacePass::Depth;
+	const double width = img->width();
+	const double height = img->height();
+	const int threadCount = workers.threadCount();
+	int batchTriangles = 0;
+	for (int chunk = 0; chunk < chunkCount; chunk++) {
+		batchTriangles += chunkTriangles[chunk].length();
+	}
+	if (usingLightSettings && colorPass) {
+		ProfileScope scope(profiler, ProfileStage::Shade);
+		workers.parallelFor(0, chunkCount, chunkCount, [&](int first, int last, int) {
+			for (int chunk = first; chunk < last; chunk++) {
+				for (SurfaceTriangle& triangle : chunkTriangles[chunk]) {
+					for (int i = 0; i < 3; i++) {
+						triangle.colors[i] = phongLightingModel(*triangle.vertices[i], *ls);
+					}
+				}
+			}
+		});
+	}
+	{
+		ProfileScope scope(profiler, ProfileStage::Setup);
+		workers.parallelFor(0, chunkCount, chunkCount, [&](int first, int last, int) {
+			for (int chunk = first; chunk < last; chunk++) {
+				const QVector<SurfaceTriangle>& triangles = chunkTriangles[chunk];
+				QVector<SurfaceHalf>& halves = chunkHalves[chunk];
+				halves.resize(2 * triangles.length());
+				int halfCount = 0;
+				double xMin = DBL_MAX, xMax = -DBL_MAX, yMin = DBL_MAX, yMax = -DBL_MAX;
+				for (int i = 0; i < triangles.length(); i++) {
+					halfCount += setupObjectTriangle(triangles[i].vertices, i, halves.data() + halfCount);
+					for (const Vertex* vertex : triangles[i].vertices) {
+						xMin = std::min(xMin, vertex->x); xMax = std::max(xMax, vertex->x);
+						yMin = std::min(yMin, vertex->y); yMax = std::max(yMax, vertex->y);
+					}
+				}
+				halves.resize(halfCount);
+				//pixels written by chunk, hierarchical depth is refreshed over them after raster
+				chunkBounds[chunk] = triangles.isEmpty() ? QRect() : QRect(QPoint(static_cast<int>(floor(std::max(xMin, -1.0))), static_cast<int>(floor(std::max(yMin, -1.0)))),
+					QPoint(static_cast<int>(floor(std::min(xMax, width))), static_cast<int>(floor(std::min(yMax, height)))));
+			}
+		});
+	}
+	{
+		ProfileScope scope(profiler, ProfileStage::Raster);
+		int bandCount = batchTriangles >= 256 ? std::min(threadCount, std::max(img->height() / 16, 1)) : 1;
+		bandShaded.fill(0, bandCount);
+		bandZTestFailed.fill(0, bandCount);
+		bandBlockRejected.fill(0, bandCount);
+		workers.parallelFor(0, img->height(), bandCount, [&](int bandBegin, int bandEnd, int band) {
+			int shaded = 0;
+			int zTestFailed = 0;
+			int blockRejected = 0;
+			for (int chunk = 0; chunk < chunkCount; chunk++) {
+				const QVector<SurfaceTriangle>& triangles = chunkTriangles[chunk];
+				for (const SurfaceHalf& half : chunkHalves[chunk]) {
+					//vertices of half are sorted by y
+					if (half.vertices[2].y < bandBegin || half.vertices[0].y >= bandEnd) {
+						continue;
+					}
+					const SurfaceTriangle& triangle = triangles[half.triangle];
+					shaded += fillObjectPolygon({ &half.vertices[0], &half.vertices[1], &half.vertices[2] }, triangle.vertices, triangle.colors, usingLightSettings, fillingAlgType,
+						bandBegin, bandEnd, zTestFailed, blockRejected, pass);
+				}
+			}
+			bandShaded[band] = shaded;
+			bandZTestFailed[band] = zTestFailed;
+			bandBlockRejected[band] = blockRejected;
+		});
+		for (int band = 0; band < bandCount && colorPass; band++) {
+			frame.pixelsShaded += bandShaded[band];
+			frame.zTestFailed += bandZTestFailed[band];
+			frame.pixelsBlockRejected += bandBlockRejected[band];
+		}
+		//triangles drawn without depth buffer leave hierarchical depth empty
+		if (occlusionCulling && pass != SurfacePass::AfterDepth && pass != SurfacePass::NoDepth) {
+			QRect drawn;
+			for (int chunk = 0; chunk < chunkCount; chunk++) {
+				drawn = drawn.united(chunkBounds[chunk]);
+			}
+			refreshHierarchicalDepth(drawn);
+		}
+	}
+}
+//Stable LSD radix sort of values by keys, one pass per byte of keyBits. Runs of chunkCount chunks count their digits
+//and scatter them in parallel, run of chunk goes after same digit of earlier chunks, so order of equal keys is kept.
+//Scratch arrays and digit offsets of chunks are given by caller and reused between frames
+template <typename T>
+static void radixSort(WorkerPool& workers, QVector<quint32>& keys, QVector<T>& values, QVector<quint32>& keysScratch, QVector<T>& valuesScratch,
+	QVector<std::array<int, 256>>& offsets, int keyBits, int chunkCount) {
+	const int count = keys.length();
+	keysScratch.resize(count);
+	valuesScratch.resize(count);
+	offsets.resize(chunkCount);
+	for (int shift = 0; shift < keyBits; shift += 8) {
+		const quint32* keyData = keys.constData();
+		const T* valueData = values.constData();
+		quint32* keyTarget = keysScratch.data();
+		T* valueTarget = valuesScratch.data();
+		for (std::array<int, 256>& histogram : offsets) {
+			histogram.fill(0);
+		}
+		workers.parallelFor(0, count, chunkCount, [&](int first, int last, int chunk) {
+			std::array<int, 256>& histogram = offsets[chunk];
+			for (int i = first; i < last; i++) {
+				histogram[(keyData[i] >> shift) & 0xff]++;
+			}
+		});
+		int position = 0;
+		for (int digit = 0; digit < 256; digit++) {
+			for (std::array<int, 256>& histogram : offsets) {
+				int digitCount = histogram[digit];
+				histogram[digit] = position;
+				position += digitCount;
+			}
+		}
+		workers.parallelFor(0, count, chunkCount, [&](int first, int last, int chunk) {
+			std::array<int, 256>& next = offsets[chunk];
+			for (int i = first; i < last; i++) {
+				int target = next[(keyData[i] >> shift) & 0xff]++;
+				keyTarget[target] = keyData[i];
+				valueTarget[target] = valueData[i];
+			}
+		});
+		std::swap(keys, keysScratch);
+		std::swap(values, valuesScratch);
+	}
+}
+void Renderer::sortMeshletsFrontToBack(int projectionType, const InstanceTransform* instance) {
+	const int count = visibleMeshlets.length();
+	if (count < 2) {
+		return;
+	}
+	//larger depth is closer, key 0 belongs to nearest cluster. Orthographic depth is taken along N,
+	//perspective one along ray from eye (on axis N at distance of camera), so clusters at side of view are ordered by their distance
+	const Vertex& N = projectionPlane.basisVectorN;
+	const Vertex eye(N.x * camera.position.z, N.y * camera.position.z, N.z * camera.position.z);
+	double zMin = DBL_MAX, zMax = -DBL_MAX;
+	meshletKeys.resize(count);
+	QVector<double>& depths = meshletDepths;
+	depths.resize(count);
+	for (int i = 0; i < count; i++) {
+		const Meshlet& meshlet = *visibleMeshlets[i];
+		Vertex center = instance != nullptr ? instance->apply(meshlet.center) : meshlet.center;
+		double radius = instance != nullptr ? meshlet.radius * instance->scale : meshlet.radius;
+		if (projectionType == 1) {
+			Vertex ray(center.x - eye.x, center.y - eye.y, center.z - eye.z);
+			depths[i] = radius - sqrt(ray * ray);
+		}
+		else {
+			depths[i] = center * N + radius;
+		}
+		zMin = std::min(zMin, depths[i]);
+		zMax = std::max(zMax, depths[i]);
+	}
+	const double scale = zMax > zMin ? 65535 / (zMax - zMin) : 0;
+	for (int i = 0; i < count; i++) {
+		meshletKeys[i] = static_cast<quint32>((zMax - depths[i]) * scale);
+	}
+	radixSort(workers, meshletKeys, visibleMeshlets, meshletKeysScratch, visibleMeshletsScratch, radixOffsets, 16, 1);
+}
+void Renderer::drawSurfaceOrdered(const Object_H_edge& object, int projectionType, int fillingAlgType, const LightSettings* ls, const InstanceTransform* instance, const QColor& color) {
+	ProfileFrame& frame = profiler.frame();
+	const double width = img->width();
+	const double height = img->height();
+	const int threadCount = workers.threadCount();
+	BspTree* tree = nullptr;
+	int objectVertices = 0;
+	if (surfaceVisibility == 1) {
+		{
+			ProfileScope scope(profiler, ProfileStage::Cull);
+			orderedTriangles.resize(0);
+			for (const Meshlet& meshlet : object.meshlets) {
+				frame.trianglesSubmitted += meshlet.triangleCount;
+				if (isMeshletCulled(meshlet, projectionType, instance)) {
+					continue;
+				}
+				for (int i = meshlet.firstFace; i < meshlet.firstFace + meshlet.faceCount; i++) {
+					Face* face = object.faces[i];
+					SurfaceTriangle triangle;
+					if (!faceTriangle(face, triangle) || isTriangleOutsideImage(triangle, width, height)) {
+						continue;
+					}
+					triangle.colors[0] = color.isValid() ? color : object.colors.value(face);
+					orderedTriangles.append(triangle);
+				}
+			}
+		}
+		ProfileScope scope(profiler, ProfileStage::Cull);
+		//painter's algorithm, larger z is closer, so key 0 belongs to farthest centroid and it's drawn first
+		const int count = orderedTriangles.length();
+		const int sortChunks = count >= 16384 ? threadCount : 1;
+		triangleDepths.resize(count);
+		triangleKeys.resize(count);
+		triangleOrder.resize(count);
+		QVector<QPair<double, double>>& chunkRanges = triangleDepthRanges;
+		chunkRanges.fill({ DBL_MAX, -DBL_MAX }, sortChunks);
+		const SurfaceTriangle* triangles = orderedTriangles.constData();
+		double* depths = triangleDepths.data();
+		workers.parallelFor(0, count, sortChunks, [&](int first, int last, int chunk) {
+			QPair<double, double> range = chunkRanges[chunk];
+			for (int i = first; i < last; i++) {
+				depths[i] = triangles[i].vertices[0]->z + triangles[i].vertices[1]->z + triangles[i].vertices[2]->z;
+				range.first = std::min(range.first, depths[i]);
+				range.second = std::max(range.second, depths[i]);
+			}
+			chunkRanges[chunk] = range;
+		});
+		double zMin = DBL_MAX, zMax = -DBL_MAX;
+		for (const QPair<double, double>& range : chunkRanges) {
+			zMin = std::min(zMin, range.first);
+			zMax = std::max(zMax, range.second);
+		}
+		const double scale = zMax > zMin ? 16777215 / (zMax - zMin) : 0;
+		quint32* keys = triangleKeys.data();
+		int* order = triangleOrder.data();
+		workers.parallelFor(0, count, sortChunks, [&](int first, int last, int) {
+			for (int i = first; i < last; i++) {
+				keys[i] = static_cast<quint32>((depths[i] - zMin) * scale);
+				order[i] = i;
+			}
+		});
+		radixSort(workers, triangleKeys, triangleOrder, triangleKeysScratch, triangleOrderScratch, radixOffsets, 24, sortChunks);
+	}
+	else {
+		//BSP tree is built from positions of object before projection, vertices of object are already projected in place
+		tree = &bspTrees[&object];
+		if (!tree->isBuiltFor(object)) {
+			ProfileScope scope(profiler, ProfileStage::Setup);
+			tree->build(object, savedVertices);
+		}
+		frame.trianglesSubmitted += object.triangle_indices.length() / 3;
+		const QVector<Vertex>& treeVertices = tree->getVertices();
+		objectVertices = tree->objectVertexCount();
+		{
+			ProfileScope scope(profiler, ProfileStage::Transform);
+			bspProjected.resize(treeVertices.length() - objectVertices);
+			for (int i = objectVertices; i < treeVertices.length(); i++) {
+				bspProjected[i - objectVertices] = projectVertex(instance != nullptr ? instance->apply(treeVertices[i]) : treeVertices[i], projectionType);
+			}
+		}
+		ProfileScope scope(profiler, ProfileStage::Cull);
+		//eye of perspective lies on axis N at distance of camera, orthographic view is along N, both in coordinates of object
+		const Vertex& N = projectionPlane.basisVectorN;
+		Vertex eye = projectionType == 1 ? Vertex(N.x * camera.position.z, N.y * camera.position.z, N.z * camera.position.z) : N;
+		if (instance != nullptr) {
+			eye = projectionType == 1 ? instance->unapply(eye) : instance->unrotate(eye);
+		}
+		tree->backToFront(eye, projectionType != 1, triangleOrder, bspStack);
+	}
+	//order is rasterized in batches, so setup buffers are bounded by batch and not by object,
+	//contiguous runs of batch go to chunks and bands rasterize chunks one after another, so order is kept
+	const int count = triangleOrder.length();
+	const int batchSize = 8192;
+	for (int batchBegin = 0; batchBegin < count; batchBegin += batchSize) {
+		int batchEnd = std::min(batchBegin + batchSize, count);
+		int chunkCount = std::max(1, std::min(threadCount, (batchEnd - batchBegin) / 512));
+		if (chunkTriangles.length() < chunkCount) {
+			chunkTriangles.resize(chunkCount);
+			chunkHalves.resize(chunkCount);
+			chunkBounds.resize(chunkCount);
+		}
+		{
+			ProfileScope scope(profiler, ProfileStage::Cull);
+			workers.parallelFor(batchBegin, batchEnd, chunkCount, [&](int first, int last, int chunk) {
+				QVector<SurfaceTriangle>& run = chunkTriangles[chunk];
+				run.resize(0);
+				for (int i = first; i < last; i++) {
+					if (tree == nullptr) {
+						run.append(orderedTriangles[triangleOrder[i]]);
+						continue;
+					}
+					const BspTriangle& source = tree->triangle(triangleOrder[i]);
+					SurfaceTriangle triangle;
+					for (int k = 0; k < 3; k++) {
+						int vertex = source.vertices[k];
+						triangle.vertices[k] = vertex < objectVertices ? object.vertices[vertex] : &bspProjected[vertex - objectVertices];
+					}
+					if (isTriangleOutsideImage(triangle, width, height)) {
+						continue;
+					}
+					triangle.colors[0] = color.isValid() ? color : object.colors.value(source.face);
+					run.append(triangle);
+				}
+			});
+		}
+		for (int chunk = 0; chunk < chunkCount; chunk++) {
+			frame.trianglesDrawn += chunkTriangles[chunk].length();
+		}
+		rasterizeChunks(chunkCount, ls, fillingAlgType, SurfacePass::NoDepth);
+	}
+}
+void Renderer::profileCoveredPixels() {
+	//overdraw needs number of covered pixels, Z-buffer is scanned only while profiling,
+	//surface without depth buffer has no covered pixels counted, only memory of its visibility
+	if (!profiler.isEnabled()) {
+		return;
+	}
+	ProfileFrame& frame = profiler.frame();
+	frame.visibilityBytes = visibilityMemory();
+	if (!profiler.isPixelCounting()) {
+		return;
+	}
+	for (double depth : z_buffer_layer_array) {
+		if (depth != -DBL_MAX) {
+			frame.pixelsCovered++;
+		}
+	}
+}
+//Writes depth of triangle into rows bandBegin .. bandEnd - 1 of depth buffer, larger z is closer,
+//plane of triangle is sampled in centers of pixels
+static void rasterizeTriangleDepth(const Vertex& A, const Vertex& B, const Vertex& C, double* depth, int width, int bandBegin, int bandEnd) {
+	double area = (B.x - A.x) * (C.y - A.y) - (B.y - A.y) * (C.x - A.x);
+	if (!(std::abs(area) > 1e-9)) {
+		return;
+	}
+	double dzdx = ((B.z - A.z) * (C.y - A.y) - (C.z - A.z) * (B.y - A.y)) / area;
+	double dzdy = ((C.z - A.z) * (B.x - A.x) - (B.z - A.z) * (C.x - A.x)) / area;
+	std::array<const Vertex*, 3> T = { &A, &B, &C };
+	std::sort(T.begin(), T.end(), [](const Vertex* vertex1, const Vertex* vertex2) { return vertex1->y < vertex2->y; });
+	int yBegin = static_cast<int>(ceil(std::max(T[0]->y, static_cast<double>(bandBegin)) - 0.5));
+	int yEnd = static_cast<int>(ceil(std::min(T[2]->y, static_cast<double>(bandEnd)) - 0.5));
+	yBegin = std::max(yBegin, bandBegin);
+	yEnd = std::min(yEnd, bandEnd);
+	for (int y = yBegin; y < yEnd; y++) {
+		double yCenter = y + 0.5;
+		//long edge T0-T2 against upper or lower short edge
+		double xa = T[0]->x + (yCenter - T[0]->y) * (T[2]->x - T[0]->x) / (T[2]->y - T[0]->y);
+		double xb = yCenter < T[1]->y ? T[0]->x + (yCenter - T[0]->y) * (T[1]->x - T[0]->x) / (T[1]->y - T[0]->y)
+			: T[1]->x + (yCenter - T[1]->y) * (T[2]->x - T[1]->x) / (T[2]->y - T[1]->y);
+		if (xa > xb) {
+			std::swap(xa, xb);
+		}
+		int xBegin = static_cast<int>(ceil(std::max(xa, 0.0) - 0.5));
+		int xEnd = static_cast<int>(ceil(std::min(xb, static_cast<double>(width)) - 0.5));
+		double z = A.z + dzdx * (xBegin + 0.5 - A.x) + dzdy * (yCenter - A.y);
+		double* row = depth + static_cast<qsizetype>(y) * width;
+		for (int x = xBegin; x < xEnd; x++) {
+			if (z > row[x]) {
+				row[x] = z;
+			}
+			z += dzdx;
+		}
+	}
+}
+void Renderer::drawWireSegment(const WireSegment& segment, int bandBegin, int bandEnd, QRgb color, bool depthTest, double bias) {
+	QPoint start = segment.start;
+	QPoint end = segment.end;
+	double zStart = segment.zStart;
+	double zEnd = segment.zEnd;
+	int width = target.width();
+	//steep segment is stepped in swapped coordinates, so driving axis is always x
+	bool steep = abs(end.y() - start.y()) > abs(end.x() - start.x());
+	if (steep) {
+		start = QPoint(start.y(), start.x());
+		end = QPoint(end.y(), end.x());
+	}
+	if (start.x() > end.x()) {
+		std::swap(start, end);
+		std::swap(zStart, zEnd);
+	}
+	int dx = end.x() - start.x();
+	double dz = dx == 0 ? 0 : (zEnd - zStart) / dx;
+	//depth of segment changes along pixel too, so tolerance grows with its slope
+	double tolerance = bias + std::abs(dz);
+	const double* depth = z_buffer_layer_array.constData();
+	auto plot = [&](int x, int y, double z, int coverage) {
+		int px = steep ? y : x;
+		int py = steep ? x : y;
+		if (coverage <= 0 || py < bandBegin || py >= bandEnd || px < 0 || px >= width) {
+			return;
+		}
+		if (depthTest && z + tolerance < depth[static_cast<qsizetype>(py) * width + px]) {
+			return;
+		}
+		if (coverage >= 256) {
+			target.setPixel(px, py, color);
+		}
+		else {
+			target.blendPixel(px, py, color, coverage);
+		}
+	};
+	if (dx == 0) {
+		plot(start.x(), start.y(), zStart, 256);
+		return;
+	}
+	//driving axis is limited to image, or to band when it runs along rows
+	int majorBegin = std::max(start.x(), steep ? bandBegin : 0);
+	int majorEnd = std::min(end.x(), steep ? bandEnd - 1 : width - 1);
+	if (!steep && end.y() != start.y()) {
+		//flat segment crosses band only between columns where it enters and leaves its rows
+		double slope = static_cast<double>(end.y() - start.y()) / dx;
+		double xa = start.x() + (bandBegin - 1 - start.y()) / slope;
+		double xb = start.x() + (bandEnd + 1 - start.y()) / slope;
+		double xLow = std::min(std::max(std::min(xa, xb), static_cast<double>(majorBegin)), static_cast<double>(majorEnd));
+		double xHigh = std::max(std::min(std::max(xa, xb), static_cast<double>(majorEnd)), static_cast<double>(majorBegin));
+		majorBegin = static_cast<int>(xLow);
+		majorEnd = std::min(static_cast<int>(xHigh) + 1, majorEnd);
+	}
+	//position on minor axis in 16.16 fixed point, rounded to nearest pixel unless its fraction is used as coverage
+	qint64 gradient = (static_cast<qint64>(end.y() - start.y()) << 16) / dx;
+	qint64 minor = (static_cast<qint64>(start.y()) << 16) + gradient * (majorBegin - start.x()) + (antialiasing ? 0 : 0x8000);
+	double z = zStart + dz * (majorBegin - start.x());
+	for (int x = majorBegin; x <= majorEnd; x++) {
+		int y = static_cast<int>(minor >> 16);
+		if (antialiasing) {
+			int fraction = static_cast<int>((minor >> 8) & 0xff);
+			plot(x, y, z, 256 - fraction);
+			plot(x, y + 1, z, fraction);
+		}
+		else {
+			plot(x, y, z, 256);
+		}
+		minor += gradient;
+		z += dz;
+	}
+}
+void Renderer::drawWireframe(const Object_H_edge& object, int projectionType) {
+	{
+		ProfileScope scope(profiler, ProfileStage::Transform);
+		projectVertices(object, projectionType);
+	}
+	drawWireframeVertices(object, projectedVertices);
+}
+void Renderer::drawWireframeVertices(const Object_H_edge& object, const QVector<Vertex>& projected) {
+	QRect imageRect = img->rect();
+	//segments are clipped once, every band of rows then rasterizes only segments crossing it
+	{
+		ProfileScope scope(profiler, ProfileStage::Cull);
+		wireSegments.resize(0);
+		//depth pass draws no lines
+		const int edgeCount = wirePass == WirePass::Depth ? 0 : object.unique_edges.length();
+		for (int e = 0; e < edgeCount; e++) {
+			const QPair<int, int>& edge = object.unique_edges[e];
+			const Vertex& A = projected[edge.first];
+			const Vertex& B = projected[edge.second];
+			WireSegment segment;
+			segment.start = QPoint(static_cast<int>(A.x), static_cast<int>(A.y));
+			segment.end = QPoint(static_cast<int>(B.x), static_cast<int>(B.y));
+			segment.zStart = A.z;
+			segment.zEnd = B.z;
+			QRect boundingBox = QRect(segment.start, segment.end).normalized();
+			if (!boundingBox.intersects(imageRect)) {
+				continue;
+			}
+			if (!isInsideGuardBand(boundingBox)) {
+				QPoint start = segment.start;
+				QPoint end = segment.end;
+				if (!cyrusBeck(start, end)) {
+					continue;
+				}
+				//depth of clipped end points is interpolated along driving axis of original segment
+				QPoint direction = segment.end - segment.start;
+				bool alongX = abs(direction.x()) >= abs(direction.y());
+				auto parameter = [&](QPoint point) {
+					return alongX ? static_cast<double>(point.x() - segment.start.x()) / direction.x() : static_cast<double>(point.y() - segment.start.y()) / direction.y();
+				};
+				double zDelta = B.z - A.z;
+				segment.zStart = A.z + zDelta * parameter(start);
+				segment.zEnd = A.z + zDelta * parameter(end);
+				segment.start = start;
+				segment.end = end;
+			}
+			wireSegments.append(segment);
+		}
+	}
+	//hidden lines are removed against depth of faces, prepass writes only Z-buffer.
+	//lines pass tests against faces of all objects, even when this one has none
+	bool depthTest = hiddenLineRemoval && (wirePass == WirePass::Lines || !object.triangle_indices.isEmpty());
+	bool drawDepth = depthTest && wirePass != WirePass::Lines;
+	double bias = 0;
+	if (depthTest) {
+		ProfileScope scope(profiler, ProfileStage::Setup);
+		if (wirePass == WirePass::Single) {
+			resetZBuffer();
+		}
+		double zMin = DBL_MAX;
+		double zMax = -DBL_MAX;
+		for (const Vertex& vertex : projected) {
+			zMin = std::min(zMin, vertex.z);
+			zMax = std::max(zMax, vertex.z);
+		}
+		bias = (zMax - zMin) * 0.01;
+	}
+	QRgb color = qRgb(0, 0, 0);
+	const QVector<int>& triangles = object.triangle_indices;
+	double* depth = z_buffer_layer_array.data();
+	int width = img->width();
+	//bands of rows write disjoint parts of image and Z-buffer, so they run in parallel
+	auto drawBand = [&](int bandBegin, int bandEnd, int) {
+		if (drawDepth) {
+			for (int i = 0; i + 2 < triangles.length(); i += 3) {
+				rasterizeTriangleDepth(projected[triangles[i]], projected[triangles[i + 1]], projected[triangles[i + 2]], depth, width, bandBegin, bandEnd);
+			}
+		}
+		for (const WireSegment& segment : wireSegments) {
+			if (std::max(segment.start.y(), segment.end.y()) < bandBegin - 1 || std::min(segment.start.y(), segment.end.y()) > bandEnd) {
+				continue;
+			}
+			drawWireSegment(segment, bandBegin, bandEnd, color, depthTest, bias);
+		}
+	};
+	//small meshes are not worth starting threads
+	int bandCount = 1;
+	if (wireSegments.length() >= 2048 || (drawDepth && triangles.length() >= 3 * 2048)) {
+		bandCount = std::min(workers.threadCount(), std::max(img->height() / 16, 1));
+	}
+	{
+		ProfileScope scope(profiler, ProfileStage::Raster);
+		workers.parallelFor(0, img->height(), bandCount, drawBand);
+	}
+	imageChanged(img->rect());
+}
+bool Renderer::sphereScreenBounds(const Vertex& center, double r, int projectionType, double& xMin, double& xMax, double& yMin, double& yMax, double& zMax) {
+	double x = center * projectionPlane.basisVectorV;
+	double y = center * projectionPlane.basisVectorU;
+	double z = center * projectionPlane.basisVectorN;
+	//depth of projected vertices is their view z in both projections
+	zMax = z + r;
+	//screen bounding box of sphere, perspective divides by distance from camera which is at least distance of its nearest point
+	xMin = x - r, xMax = x + r, yMin = y - r, yMax = y + r;
+	if (projectionType == 1) {
+		double nearDistance = camera.position.z - z - r;
+		if (nearDistance <= 0) {
+			return false;
+		}
+		double farDistance = camera.position.z - z + r;
+		std::array<double, 4> xs = { (x - r) / nearDistance, (x - r) / farDistance, (x + r) / nearDistance, (x + r) / farDistance };
+		std::array<double, 4> ys = { (y - r) / nearDistance, (y - r) / farDistance, (y + r) / nearDistance, (y + r) / farDistance };
+		xMin = camera.position.z * *std::min_element(xs.begin(), xs.end());
+		xMax = camera.position.z * *std::max_element(xs.begin(), xs.end());
+		yMin = camera.position.z * *std::min_element(ys.begin(), ys.end());
+		yMax = camera.position.z * *std::max_element(ys.begin(), ys.end());
+	}
+	double correctionX = static_cast<double>(img->width()) / 2;
+	double correctionY = static_cast<double>(img->height()) / 2;
+	xMin += correctionX; xMax += correctionX;
+	yMin += correctionY; yMax += correctionY;
+	return true;
+}
+bool Renderer::isSphereOutsideImage(const Vertex& center, double r, int projectionType) {
+	double xMin, xMax, yMin, yMax, zMax;
+	if (!sphereScreenBounds(center, r, projectionType, xMin, xMax, yMin, yMax, zMax)) {
+		return false;
+	}
+	return xMax < 0 || xMin >= img->width() || yMax < 0 || yMin >= img->height();
+}
+bool Renderer::isSphereOccluded(const Vertex& center, double r, int projectionType) {
+	double xMin, xMax, yMin, yMax, zMax;
+	if (!sphereScreenBounds(center, r, projectionType, xMin, xMax, yMin, yMax, zMax)) {
+		return false;
+	}
+	return isBoxOccluded(xMin, xMax, yMin, yMax, zMax);
+}
+bool Renderer::isBoxOccluded(double xMin, double xMax, double yMin, double yMax, double zMax) {
+	if (hiZLevels.isEmpty()) {
+		return false;
+	}
+	//filler writes pixels from integer part of span ends, so box is widened to whole pixels
+	int x0 = static_cast<int>(floor(std::max(xMin, 0.0))), x1 = static_cast<int>(floor(std::min(xMax, img->width() - 1.0)));
+	int y0 = static_cast<int>(floor(std::max(yMin, 0.0))), y1 = static_cast<int>(floor(std::min(yMax, img->height() - 1.0)));
+	if (x0 > x1 || y0 > y1) {
+		return false;
+	}
+	//coarser level is taken while box covers more than 4x4 of its tiles
+	int tx0 = x0 / 8, tx1 = x1 / 8, ty0 = y0 / 8, ty1 = y1 / 8;
+	int level = 0;
+	while ((tx1 - tx0 > 3 || ty1 - ty0 > 3) && level + 1 < hiZLevels.length()) {
+		tx0 /= 2; tx1 /= 2; ty0 /= 2; ty1 /= 2;
+		level++;
+	}
+	const QVector<double>& tiles = hiZLevels[level];
+	const int tilesWidth = hiZSizes[level].width();
+	for (int ty = ty0; ty <= ty1; ty++) {
+		for (int tx = tx0; tx <= tx1; tx++) {
+			if (!(zMax < tiles[ty * tilesWidth + tx])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+bool Renderer::isMeshletCulled(const Meshlet& meshlet, int projectionType, const InstanceTransform* instance) {
+	//bounds of cluster are moved with instance, its normals are only rotated
+	Vertex center = instance != nullptr ? instance->apply(meshlet.center) : meshlet.center;
+	double r = instance != nullptr ? meshlet.radius * instance->scale : meshlet.radius;
+	if (isSphereOutsideImage(center, r, projectionType)) {
+		return true;
+	}
+	if (!backFaceCulling || meshlet.coneCutoff > 1) {
+		return false;
+	}
+	//larger z is closer, orthographic camera looks along -N, perspective camera sits on N at its distance
+	const Vertex& N = projectionPlane.basisVectorN;
+	QVector3D axis = instance != nullptr ? instance->rotate(meshlet.coneAxis) : meshlet.coneAxis;
+	if (projectionType == 1) {
+		QVector3D direction = center.toQVector3D() - camera.position.z * N.toQVector3D();
+		return QVector3D::dotProduct(direction, axis) >= meshlet.coneCutoff * direction.length() + r;
+	}
+	return QVector3D::dotProduct(-N.toQVector3D(), axis) >= meshlet.coneCutoff;
+}
+Vertex Renderer::projectVertex(const Vertex& vertex, int projectionType) {
+	//Defining translation to center where better time complexity
+	double correctionX = static_cast<double>(img->width()) / 2;
+	double correctionY = static_cast<double>(img->height()) / 2;
+	//calculating new projection coordinates
+	Vertex newVertex(vertex * projectionPlane.basisVectorV, vertex * projectionPlane.basisVectorU, vertex * projectionPlane.basisVectorN);
+	//Perspective Projection
+	if (projectionType == 1) {
+		newVertex.x = camera.position.z * newVertex.x / (camera.position.z - newVertex.z);
+		newVertex.y = camera.position.z * newVertex.y / (camera.position.z - newVertex.z);
+	}
+	return Vertex(correctionX, correctionY, 0) + newVertex;
+}
+void Renderer::perspectiveCoordSystemTransformation(const Object_H_edge& object, int projectionType, QVector<Vertex>& oldVertices) {
+	//old vertices are written into caller's buffer, no allocation once it has the right size
+	oldVertices.resize(object.vertices.length());
+	int vertexIndex = 0;
+	for (Vertex* vertex : object.vertices) {
+		oldVertices[vertexIndex++] = *vertex;
+		Vertex newVertex = projectVertex(*vertex, projectionType);
+		vertex->x = newVertex.x;
+		vertex->y = newVertex.y;
+		vertex->z = newVertex.z;
+	}
+}
+const QVector<Vertex>& Renderer::projectVertices(const Object_H_edge& object, int projectionType) {
+	ProjectionKey key;
+	key.object = object.vertices.constData();
+	key.vertexCount = object.vertices.length();
+	key.projectionType = projectionType;
+	key.azimut = projectionPlane.azimut;
+	key.zenit = projectionPlane.zenit;
+	key.cameraZ = camera.position.z;
+	key.imageSize = img->size();
+	if (key == projectedVerticesKey) {
+		return projectedVertices;
+	}
+	projectedVertices.resize(object.vertices.length());
+	for (int i = 0; i < object.vertices.length(); i++) {
+		projectedVertices[i] = projectVertex(*object.vertices[i], projectionType);
+	}
+	projectedVerticesKey = key;
+	return projectedVertices;
+}
+double Renderer::baricentricInterpolation(const QVector<Vertex*>& T, Vertex* P) {
+	double lambda[3];
+	lambda[0] = abs((T[1]->x - P->x) * (T[2]->y - P->y) - (T[1]->y - P->y) * (T[2]->x - P->x));
+	lambda[0] /= abs(static_cast<double>(T[1]->x - T[0]->x) * (T[2]->y - T[0]->y) - (T[1]->y - T[0]->y) * (T[2]->x - T[0]->x));
+
+	lambda[1] = abs((T[0]->x - P->x) * (T[2]->y - P->y) - (T[0]->y - P->y) * (T[2]->x - P->x));
+	lambda[1] /= abs(static_cast<double>(T[1]->x - T[0]->x) * (T[2]->y - T[0]->y) - (T[1]->y - T[0]->y) * (T[2]->x - T[0]->x));
+
+	lambda[2] = 1 - lambda[0] - lambda[1];
+
+	return T[0]->z * lambda[0] + T[1]->z * lambda[1] + T[2]->z * lambda[2];
+}
+QColor Renderer::phongLightingModel(const Vertex& vertex, const LightSettings& ls) {
+	// inicializing vectors N(normal) L(light) V(viewer) R(reflexion)
+	QVector3D N = vertex.toQVector3D().normalized();
+	QVector3D L = (ls.lightPosition - vertex).toQVector3D().normalized();
+	QVector3D V = (camera.position - vertex).toQVector3D().normalized();
+	QVector3D R = (2 * (QVector3D::dotProduct(L, N)) * N - L).normalized();
+	//-------------------
+	double red = 0;
+	double green = 0;
+	double blue = 0;
+
+	if (QVector3D::dotProduct(L, N) > 0) {
+		double coef;
+		//Reflexion part of phong model
+		if (QVector3D::dotProduct(V, R) > 0) {
+			coef = ls.rs * pow(QVector3D::dotProduct(V, R), ls.h);
+			red += ls.lightIntesity.red() * coef;
+			green += ls.lightIntesity.green() * coef;
+			blue += ls.lightIntesity.blue() * coef;
+		}
+		//Difusion part of phong model
+		coef = ls.rd * QVector3D::dotProduct(L, N);
+		red += ls.lightIntesity.red() * coef;
+		green += ls.lightIntesity.green() * coef;
+		blue += ls.lightIntesity.blue() * coef;
+	}
+	//Ambient part of phong model
+	red += ls.lightIntesityAmbient.red() * ls.ra;
+	green += ls.lightIntesityAmbient.green() * ls.ra;
+	blue += ls.lightIntesityAmbient.blue() * ls.ra;
+
+	return QColor(std::max(std::min(static_cast<int>(red), 255),0), std::max(std::min(static_cast<int>(green), 255) , 0), std::max(std::min(static_cast<int>(blue), 255),0));
+}
+int Renderer::setupObjectTriangle(const std::array<Vertex*, 3>& vertices, int triangle, SurfaceHalf* halves) {
+	std::array<const Vertex*, 3> T = { vertices[0], vertices[1], vertices[2] };
+	//Sorting all vertices primarly with their y-coordinate and secondary with their x-coordinate
+	std::sort(T.begin(), T.end(), [](const Vertex* vertex1, const Vertex* vertex2) {
+		return vertex1->y < vertex2->y || vertex1->y == vertex2->y && vertex1->x < vertex2->x;
+		});
+	halves[0].triangle = triangle;
+	if (T[0]->y == T[1]->y || T[1]->y == T[2]->y) {
+		halves[0].vertices = { *T[0], *T[1], *T[2] };
+		return 1;
+	}
+	double m = static_cast<double>(T[2]->y - T[0]->y) / (T[2]->x - T[0]->x);
+	//splitting vertex, its depth isn't used, fill interpolates from original vertices
+	Vertex P((T[1]->y - T[0]->y) / m + T[0]->x, T[1]->y, 0);
+	halves[1].triangle = triangle;
+	if (T[1]->x < P.x) {
+		halves[0].vertices = { *T[0], *T[1], P };
+		halves[1].vertices = { *T[1], P, *T[2] };
+	}
+	else {
+		halves[0].vertices = { *T[0], P, *T[1] };
+		halves[1].vertices = { P, *T[1], *T[2] };
+	}
+	return 2;
+}
+int Renderer::fillObjectPolygon(const std::array<const Vertex*, 3>& vertices, const std::array<Vertex*, 3>& oldVertices, const std::array<QColor, 3>& colors, bool usingLightSettings, int fillAlgType,
+	int bandBegin, int bandEnd, int& zTestFailed, int& blockRejected, SurfacePass pass) {
+	struct Edge {
+		Vertex start;
+		Vertex end;
+		double m = 0;
+	};
+	//Interpolation that interpolates thru given Point and Vertices of triangle
+	//creating cosnt variables for better time complexitya
+	const double T0x = oldVertices[0]->x;
+	const double T0y = oldVertices[0]->y;
+	const double T0z = oldVertices[0]->z;
+	const double T1x = oldVertices[1]->x;
+	const double T1y = oldVertices[1]->y;
+	const double T1z = oldVertices[1]->z;
+	const double T2x = oldVertices[2]->x;
+	const double T2y = oldVertices[2]->y;
+	const double T2z = oldVertices[2]->z;
+	//blocks are tested only when triangle's nearest vertex is behind tile, others would be drawn anyway
+	const double nearestZ = std::max({ T0z, T1z, T2z });
+	//color values
+	const int C0R = colors.at(0).red();
+	const int C0G = colors.at(0).green();
+	const int C0B = colors.at(0).blue();
+	const int C1R = colors.at(1).red();
+	const int C1G = colors.at(1).green();
+	const int C1B = colors.at(1).blue();
+	const int C2R = colors.at(2).red();
+	const int C2G = colors.at(2).green();
+	const int C2B = colors.at(2).blue();
+
+	auto interpolation = [&](const Vertex& P, double& lambda1, double& lambda2, double& lambda3)->void  {
+		const double Px = P.x;
+		const double Py = P.y;
+		const double divider = abs((T1x - T0x) * (T2y - T0y) - (T1y - T0y) * (T2x - T0x));
+		lambda1 = abs((T1x - Px) * (T2y - Py) - (T1y - Py) * (T2x - Px)) / divider;
+		lambda2 = abs((T0x - Px) * (T2y - Py) - (T0y - Py) * (T2x - Px)) / divider;
+		lambda3 = 1 - lambda1 - lambda2;
+	};
+
+	//Largest depth interpolation gives in pixels x0 .. x1 of row, absolute values of areas are bounded at ends of block,
+	//so bound holds also for pixels of span lying outside of thin triangle
+	auto blockNearestZ = [&](double x0, double x1, double y)->double {
+		const double divider = abs((T1x - T0x) * (T2y - T0y) - (T1y - T0y) * (T2x - T0x));
+		auto range = [&](double Ax, double Ay, double Bx, double By, double& low, double& high) {
+			double a0 = (Ax - x0) * (By - y) - (Ay - y) * (Bx - x0);
+			double a1 = (Ax - x1) * (By - y) - (Ay - y) * (Bx - x1);
+			high = std::max(abs(a0), abs(a1)) / divider;
+			low = a0 * a1 <= 0 ? 0 : std::min(abs(a0), abs(a1)) / divider;
+		};
+		double low1, high1, low2, high2;
+		range(T1x, T1y, T2x, T2y, low1, high1);
+		range(T0x, T0y, T2x, T2y, low2, high2);
+		return T2z + (T0z > T2z ? high1 : low1) * (T0z - T2z) + (T1z > T2z ? high2 : low2) * (T1z - T2z);
+	};
+
+	const std::array<QRgb, 3> rgbColors = { colors[0].rgba(), colors[1].rgba(), colors[2].rgba() };
+	auto nearestNeighbour = [&](const Vertex& P) ->QRgb {
+		double const distance0 = sqrt(pow(P.x - T0x, 2) + pow(P.y - T0y, 2));
+		double const distance1 = sqrt(pow(P.x - T1x, 2) + pow(P.y - T1y, 2));
+		double const distance2 = sqrt(pow(P.x - T2x, 2) + pow(P.y - T2y, 2));
+
+		if (distance0 <= distance1 && distance0 <= distance2) {
+			return rgbColors[0];
+		}
+		else if (distance1 <= distance2 && distance1 <= distance0) {
+			return rgbColors[1];
+		}
+		else if (distance2 <= distance1 && distance2 <= distance0) {
+			return rgbColors[2];
+		}
+		return rgbColors[0];
+	};
+
+
+
+	Edge edges[3];
+	int edgeCount = 0;
+	QRgb color = rgbColors[0];
+	Vertex start = *vertices[2];
+	for (int i = 0; i < 3; i++) {
+		Vertex end = *vertices[i];
+		if (start.y > end.y) {
+			std::swap(start, end);
+		}
+		if (start.y != end.y) {
+			Edge edge;
+			edge.start = start;
+			edge.end = end;
+			edge.m = static_cast<double>(end.y - start.y) / (end.x - start.x);
+			edges[edgeCount++] = edge;
+		}
+		start = *vertices[i];
+	}
+	if (edgeCount != 2) {
+		return 0;
+	}
+	if (edges[0].end.x > edges[1].end.x) {
+		std::swap(edges[0], edges[1]);
+	}
+	int ymin = edges[0].start.y;
+	int ymax = edges[0].end.y;
+	double x1 = edges[0].start.x;
+	double x2 = edges[1].start.x;
+	double red = 0, green = 0, blue = 0;
+	double lambda0, lambda1, lambda2;
+	double z;
+	//current Vertex  indicates itteration position in image
+	Vertex currentVertex = Vertex(static_cast<int>(x1), ymin,0);
+	const int width = target.width();
+	int shaded = 0;
+	for (int y = ymin ; y < ymax; y++) {
+		//rows are clamped to band, edges are stepped from top of half so every band computes same spans
+		if (y >= bandEnd) {
+			break;
+		}
+		if (y >= bandBegin) {
+			//triangles ordered back to front have no depth buffer, later one overwrites earlier
+			double* zRow = pass == SurfacePass::NoDepth ? nullptr : z_buffer_layer_array.data() + y * width;
+			quint32* pixelRow = target.row(y);
+			const double* tileRow = occlusionCulling && zRow != nullptr && !hiZLevels.isEmpty() ? hiZLevels[0].constData() + (y / 8) * hiZSizes[0].width() : nullptr;
+			int xBegin = std::max(static_cast<int>(x1), 0);
+			int xEnd = std::min(static_cast<int>(x2), width - 1);
+			for (int x = xBegin; x <= xEnd; x++) {
+				//at start of every block of tile, block is skipped when triangle stays behind farthest depth of tile
+				if (tileRow != nullptr && (x == xBegin || x % 8 == 0) && nearestZ < tileRow[x / 8]) {
+					int blockEnd = std::min(x | 7, xEnd);
+					double farthest = tileRow[x / 8];
+					if (blockNearestZ(x, blockEnd, currentVertex.y) + 1e-9 * (1 + abs(farthest)) < farthest) {
+						blockRejected += blockEnd - x + 1;
+						x = blockEnd;
+						continue;
+					}
+				}
+				currentVertex.x = x;
+				interpolation(currentVertex, lambda0, lambda1, lambda2);
+				z = lambda0 * T0z + lambda1 * T1z + lambda2 * T2z;
+				//after depth prepass only pixels at final depth pass
+				if (zRow == nullptr || (pass == SurfacePass::AfterDepth ? z >= zRow[x] : z > zRow[x])) {
+					if (pass == SurfacePass::Depth) {
+						zRow[x] = z;
+						continue;
+					}
+					if (usingLightSettings) {
+						if (fillAlgType == 1) {
+							red = lambda0 * C0R + lambda1 * C1R + lambda2 * C2R;
+							green = lambda0 * C0G + lambda1 * C1G + lambda2 * C2G;
+							blue = lambda0 * C0B + lambda1 * C1B + lambda2 * C2B;
+							color = qRgb(static_cast<int>(red), static_cast<int> (green), static_cast<int> (blue));
+							red = 0; green = 0; blue = 0;
+						}
+						else {
+							color = nearestNeighbour(currentVertex);
+						}
+					}
+					//pixel is taken by first triangle at final depth, same as when drawn in single pass
+					if (zRow != nullptr) {
+						zRow[x] = pass == SurfacePass::AfterDepth ? std::nextafter(z, DBL_MAX) : z;
+					}
+					pixelRow[x] = color;
+					shaded++;
+				}
+				else {
+					zTestFailed++;
+				}
+			}
+		}
+		x1 += 1 / edges[0].m;
+		x2 += 1 / edges[1].m;
+		currentVertex.y++;
+	}
+	return shaded;
+}
+
+//Crop functions
+bool Renderer::cyrusBeck(QPoint& P1, QPoint& P2) {
+	//line is cropped in place, false is returned when nothing is left to draw
+	if (P1.x() < 0 && P2.x() < 0 || P1.x() > img->width() && P2.x() > img->width() ||
+		P1.y() < 0 && P2.y() < 0 || P1.y() > img->height() && P2.y() > img->height()) {
+		return false;
+	}
+	if (!isInside(P1.x(), P1.y()) || !isInside(P2.x(), P2.y())) {
+		double tMin = 0;
+		double tMax = 1;
+		QPoint vectorD = P2 - P1;
+		QPoint E[4] = { QPoint(0,0),
+			QPoint(0,img->height()),
+			QPoint(img->width(),img->height()),
+			QPoint(img->width(),0) };
+		for (int i = 0; i < 4; i++) {
+			QPoint lineVector;
+			if (i < 3) {
+				lineVector = E[i + 1] - E[i];
+			}
+			else {
+				lineVector = E[0] - E[i];
+			}
+			QPoint normalVector = QPoint(lineVector.y(), -lineVector.x());
+			QPoint vectorW = P1 - E[i];
+			int dotProductDN = vectorD.x() * normalVector.x() + vectorD.y() * normalVector.y();
+			int dotProductWN = vectorW.x() * normalVector.x() + vectorW.y() * normalVector.y();
+			if (dotProductDN != 0) {
+				double t = -static_cast<double>(dotProductWN) / dotProductDN;
+				if (dotProductDN > 0 && t <= 1) {
+					tMin = std::max(t, tMin);
+				}
+				else if (dotProductDN < 0 && t >= 0) {
+					tMax = std::min(t, tMax);
+				}
+			}
+		}
+		if (tMin < tMax) {
+			QPoint newP1 = P1 + (P2 - P1) * tMin;
+			QPoint newP2 = P1 + (P2 - P1) * tMax;
+			P1 = newP1;
+			P2 = newP2;
+			return true;
+		}
+		else {
+			return false;
+		}
+	}
+	else {
+		return true;
+	}
+}
+const QVector<QPoint>& Renderer::sutherlandHodgman(const QVector<QPoint>& points) {
+	//clipping runs in floating point between two member buffers, points are rounded only once at the end,
+	//returned reference stays valid until next call
+	QVector<QPointF>& V = clipPolygonBufferF;
+	QVector<QPointF>& W = clipPolygonBufferBackF;
+	clipPolygonBuffer.resize(0);
+	V.resize(points.length());
+	std::copy(points.begin(), points.end(), V.begin());
+	double xMax = img->width();
+	double yMax = img->height();
+	for (int j = 0; j < 4 && !V.isEmpty(); j++) {
+		// signed distance from j-th edge of image, point is inside when it is not negative
+		auto distance = [j, xMax, yMax](const QPointF& point) -> double {
+			switch (j) {
+			case 0: return point.x();
+			case 1: return point.y();
+			case 2: return xMax - point.x();
+			default: return yMax - point.y();
+			}
+			};
+		W.resize(0);
+		QPointF S = V.last();
+		double distanceS = distance(S);
+		for (const QPointF& E : V) {
+			double distanceE = distance(E);
+			if ((distanceE >= 0) != (distanceS >= 0)) {
+				W.append(S + (E - S) * (distanceS / (distanceS - distanceE)));
+			}
+			if (distanceE >= 0) {
+				W.append(E);
+			}
+			S = E;
+			distanceS = distanceE;
+		}
+		V.swap(W);
+	}
+	//consecutive points falling into the same pixel are merged
+	for (const QPointF& point : V) {
+		QPoint roundedPoint = point.toPoint();
+		if (clipPolygonBuffer.isEmpty() || clipPolygonBuffer.last() != roundedPoint) {
+			clipPolygonBuffer.append(roundedPoint);
+		}
+	}
+	if (clipPolygonBuffer.length() > 1 && clipPolygonBuffer.first() == clipPolygonBuffer.last()) {
+		clipPolygonBuffer.removeLast();
+	}
+	return clipPolygonBuffer;
+}
+
+void Renderer::clear()
+{
+	img->fill(Qt::white);
+	imageChanged(img->rect());
+}
+
+//---------------------VTK file functions------------------------------
+
+void writeCubeVTK(QTextStream& out, double d) {
+	QVector<Vertex> vertices = {
+		Vertex(0, 0, 0), Vertex(0, d, 0), Vertex(d, d, 0), Vertex(d, 0, 0),
+		Vertex(0,0,d), Vertex(0,d,d), Vertex(d,d,d), Vertex(d,0,d) };
+
+	out << "#vtk DataFile Version 3.0\n";
+	out << "vtk output\nASCII\nDATASET POLYDATA\n";
+	out << "POINTS " << vertices.size() << " float\n";
+	for (int i = 0; i < vertices.size(); i++) {
+		out << vertices[i].x  - d/2<< " " << vertices[i].y  - d/2<< " " << vertices[i].z - d/2<< "\n";
+	}
+	out << "POLYGONS 12 48\n";
+	out << "3 0 1 3\n";
+	out << "3 1 2 3\n";
+	out << "3 0 1 5\n";
+	out << "3 0 4 5\n";
+	out << "3 0 3 4\n";
+	out << "3 3 7 4\n";
+	out << "3 3 2 7\n";
+	out << "3 2 6 7\n";
+	out << "3 1 5 6\n";
+	out << "3 2 1 6\n";
+	out << "3 4 7 5\n";
+	out << "3 5 7 6\n";
+}
+void createCubeVTK(double d, const QString& filename) {
+	QFile file(filename + ".vtk");
+
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		QTextStream out(&file);
+		writeCubeVTK(out, d);
+		out.flush();
+		file.close();
+		qDebug() << "file saved sucssefully";
+	}
+	else {
+		qDebug() << "file wasnt open";
+	}
+}
+
+void createCubeVTK(const QVector<Vertex>& vertices, const QString& filename) {
+	QFile file(filename + ".vtk");
+
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		QTextStream out(&file);
+		out << "#vtk DataFile Version 3.0\n";
+		out << "vtk output\nASCII\nDATASET POLYDATA\n";
+		out << "POINTS " << vertices.size() << "int\n";
+		for (int i = 0; i < vertices.size(); i++) {
+			out << vertices[i].x << " " << vertices[i].y << " " << vertices[i].z << "\n";
+		}
+		out << "POLYGONS 12 48" << "\n";
+		out << "3 0 1 3\n";
+		out << "3 1 2 3\n";
+		out << "3 0 1 5\n";
+		out << "3 0 4 5\n";
+		out << "3 0 3 4\n";
+		out << "3 3 7 4\n";
+		out << "3 3 2 7\n";
+		out << "3 2 6 7\n";
+		out << "3 1 5 6\n";
+		out << "3 2 1 6\n";
+		out << "3 4 7 5\n";
+		out << "3 5 7 6\n";
+		file.close();
+		qDebug() << "file saved sucssefully";
+	}
+	else {
+		qDebug() << "file wasnt open";
+	}
+}
+
+Object_H_edge readPolygonsVTK(QTextStream& input) {
+	QVector<Vertex*> vertices;
+	QVector<Face*> faces;
+	QHash<Face*, QColor> colors;
+	QHash <QPair<int, int>, H_edge*> edgeMap;
+	QHash <Vertex*, int> vertexIndexMap;
+	QVector<H_edge*> edges;
+	// Inicialization of random generator for generating colors of faces
+	std::random_device rd;
+	std::mt19937 gen(rd());
+	std::uniform_int_distribution<int> dis(0, 255);
+
+	QString fileHeader = "";
+	for (int i = 0; i < 4; i++) {
+		fileHeader += input.readLine() + "\n";
+	}
+	qDebug() << fileHeader;
+	if (fileHeader != VTK_FILE_HEADER) {
+		qDebug() << "File format is incorrect";
+		return Object_H_edge();
+	}
+	QVector<QString> headerData = input.readLine().split(' ');
+	bool isInt;
+	int pointCount = headerData[1].toInt(&isInt);
+	qDebug() << headerData;
+	if (headerData[0] != "POINTS" || !isInt || (headerData[2] != "int" && headerData[2] != "float")) {
+		qDebug() << "Content of file has wrong format";
+		return Object_H_edge();
+	}
+	for (int i = 0; i < pointCount; i++) {
+		QVector<QString> points = input.readLine().split(' ');
+		if (points.length() != 3) {
+			qDebug() << "Invalid point count";
+			return Object_H_edge();
+		}
+		Vertex *vertex = new Vertex(points[0].toDouble(), points[1].toDouble(), points[2].toDouble());
+		vertices.append(vertex);
+		vertexIndexMap.insert(vertices.last(), i);
+	}
+	QString objectType = "";
+	int polygonCount = 0;
+	int valueCount = 0;
+	input >> objectType >> polygonCount >> valueCount;
+	input.readLine();
+	for (int i = 0; i < polygonCount; i++) {
+		QString str = input.readLine();
+		QVector<QString> data = str.split(' ');
+		if (data.length() < 4) {
+			return Object_H_edge();
+		}
+		QVector<int> vertexIndex;
+		for (int j = 1; j < data.length(); j++) {
+			vertexIndex.append(data[j].toInt());
+		}
+		int edgesInPolygonCount = data[0].toInt();
+		QVector<H_edge*> edgesInPolygon(edgesInPolygonCount);
+		for (int j = 0; j < edgesInPolygonCount; j++) {
+			edgesInPolygon[j] = new H_edge(vertices[vertexIndex[j]], nullptr, nullptr, nullptr, nullptr);
+		}
+		Face* currentFace = new Face(edgesInPolygon[0]);
+		faces.append(currentFace);
+		QColor currentColor(dis(gen), dis(gen), dis(gen), 255);
+		colors.insert(currentFace, currentColor);
+		for (int j = 0; j < edgesInPolygonCount; j++) {
+			if (j != edgesInPolygonCount - 1) {
+				edgesInPolygon[j]->edge_next = edgesInPolygon[j + 1];
+			}
+			else {
+				edgesInPolygon[j]->edge_next = edgesInPolygon.first();
+			}
+			if (j != 0) {
+				edgesInPolygon[j]->edge_prev = edgesInPolygon[j - 1];
+			}
+			else {
+				edgesInPolygon[j]->edge_prev = edgesInPolygon.last();
+			}
+			edgesInPolygon[j]->face = currentFace;
+			int indexOfEdgeStart = vertexIndexMap.value(edgesInPolygon[j]->vert_origin);
+			int indexOfEdgeEnd = vertexIndexMap.value(edgesInPolygon[j]->edge_next->vert_origin);
+			if (edgeMap.contains({ indexOfEdgeEnd, indexOfEdgeStart })) {
+				edgesInPolygon[j]->pair = edgeMap[{indexOfEdgeEnd, indexOfEdgeStart}];
+				edgesInPolygon[j]->pair->pair = edgesInPolygon[j];
+				edgeMap.remove({indexOfEdgeEnd, indexOfEdgeStart});
+			}
+			else {
+				edgeMap.insert({ indexOfEdgeStart, indexOfEdgeEnd }, edgesInPolygon[j]);
+			}
+		}
+		edges.append(edgesInPolygon);
+	}
+	Object_H_edge object(std::move(vertices), std::move(edges), std::move(faces));
+	object.colors = std::move(colors);
+	return object;
+}
+Object_H_edge loadPolygonsVTK(const QString& filename) {
+	QFile file(filename);
+	if (file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+		QTextStream input(&file);
+		Object_H_edge object = readPolygonsVTK(input);
+		file.close();
+		if (!object.vertices.isEmpty()) {
+			qDebug() << filename << " : file has been loaded";
+		}
+		return object;
+	}
+	else {
+		qDebug() << filename << " : file failed to open";
+		return Object_H_edge();
+	}
+}
+
+void writePolygonsVTK(QTextStream& output, const Object_H_edge& object) {
+	QHash <Vertex*, int> vertexIndexMap;
+	output << VTK_FILE_HEADER;
+	output << "POINTS " << object.vertices.length() << " float\n";
+	for (int i = 0; i < object.vertices.length(); i++) {
+		output << object.vertices[i]->x << " " << object.vertices[i]->y << " " << object.vertices[i]->z << "\n";
+		vertexIndexMap.insert(object.vertices[i], i);
+	}
+	QString polygonData = "";
+	int polygonDataLength = 0;
+	for (const Face *face : object.faces) {
+		int dataLenght = 0;
+		QString polygonDataLine = "";
+		H_edge *firstEdge = face->edge;
+		polygonDataLine.append(" " + QString::number(vertexIndexMap.value(firstEdge->vert_origin)));
+		H_edge *currentEdge = firstEdge->edge_next;
+		polygonDataLine.append(" " + QString::number(vertexIndexMap.value(currentEdge->vert_origin)));
+		H_edge *nextEdge = currentEdge;
+		dataLenght = 2;
+		while(*nextEdge != *firstEdge->edge_prev) {
+			nextEdge = currentEdge->edge_next;
+			polygonDataLine.append(" " + QString::number(vertexIndexMap.value(nextEdge->vert_origin)));
+			dataLenght++;
+			currentEdge = nextEdge;
+		}
+		polygonDataLine.push_front(QString::number(dataLenght));
+		polygonDataLength += 1 + dataLenght;
+		polygonData += polygonDataLine + "\n";
+	}
+	polygonData.push_front("POLYGONS " + QString::number(object.faces.length()) + " " + QString::number(polygonDataLength) + "\n");
+	output << polygonData;
+}
+bool savePolygonsVTK(const QString& filename, const Object_H_edge& object) {
+	QFile file(filename + ".vtk");
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		QTextStream output(&file);
+		writePolygonsVTK(output, object);
+		output.flush();
+		file.close();
+		qDebug() << filename << " : writing to file succsesfull";
+		return true;
+	}
+	else {
+		qDebug() << filename << " : file failed to open";
+		return false;
+	}
+}
+
+//Placement "x y z rotationX rotationY rotationZ scale [#rrggbb]" starting at item first of line
+static bool parseInstance(const QStringList& data, int first, ObjectInstance& instance) {
+	if (data.length() != first + 7 && data.length() != first + 8) {
+		return false;
+	}
+	double values[7];
+	for (int i = 0; i < 7; i++) {
+		bool ok = false;
+		values[i] = data[first + i].toDouble(&ok);
+		if (!ok) {
+			return false;
+		}
+	}
+	instance.translation = Vertex(values[0], values[1], values[2]);
+	instance.rotationX = values[3] * M_PI / 180;
+	instance.rotationY = values[4] * M_PI / 180;
+	instance.rotationZ = values[5] * M_PI / 180;
+	instance.scale = values[6];
+	if (data.length() == first + 8) {
+		instance.color = QColor(data[first + 7]);
+		return instance.color.isValid();
+	}
+	return true;
+}
+bool readInstances(QTextStream& in, QVector<ObjectInstance>& instances) {
+	instances.clear();
+	if (in.readLine().trimmed() != "MODELVIEWER INSTANCES FORMAT") {
+		return false;
+	}
+	while (!in.atEnd()) {
+		QString line = in.readLine().trimmed();
+		if (line.isEmpty()) {
+			continue;
+		}
+		ObjectInstance instance;
+		if (!parseInstance(line.split(' ', Qt::SkipEmptyParts), 0, instance)) {
+			qDebug() << "Invalid instance:" << line;
+			return false;
+		}
+		instances.append(instance);
+	}
+	return true;
+}
+bool readAssembly(QTextStream& in, const QString& directory, Scene3D& scene) {
+	scene.clear();
+	if (in.readLine().trimmed() != "MODELVIEWER ASSEMBLY FORMAT") {
+		return false;
+	}
+	//mesh index of every file already loaded
+	QHash<QString, int> loadedMeshes;
+	while (!in.atEnd()) {
+		QString line = in.readLine().trimmed();
+		if (line.isEmpty()) {
+			continue;
+		}
+		QStringList data = line.split(' ', Qt::SkipEmptyParts);
+		ObjectInstance placement;
+		if (!parseInstance(data, 1, placement)) {
+			qDebug() << "Invalid assembly object:" << line;
+			scene.clear();
+			return false;
+		}
+		QString filename = QDir(directory).filePath(data[0]);
+		if (!loadedMeshes.contains(filename)) {
+			Object_H_edge mesh = loadPolygonsVTK(filename);
+			if (mesh.vertices.isEmpty()) {
+				scene.clear();
+				return false;
+			}
+			loadedMeshes.insert(filename, scene.addMesh(std::move(mesh)));
+		}
+		scene.addObject(loadedMeshes.value(filename), placement);
+	}
+	scene.buildHierarchy();
+	return true;
+}
+
+//Reads 2D scene in MODELVIEWER 2D SCENE FORMAT, returns false when file doesn't match it
+bool readSceneState(QTextStream& in, QSize& size, QMap<QString, Object2D>& objects) {
+	bool correct_format = true;
+	int width = 0;
+	int height = 0;
+	if (in.readLine().trimmed() != "MODELVIEWER 2D SCENE FORMAT") {
+		correct_format = false;
+	}
+	QString file_line = in.readLine();
+	QList<QString> file_data = file_line.split(":");
+	if (file_data.length() != 3 || file_data[0] != "SIZE") {
+		correct_format = false;
+	}
+	else {
+		width = file_data[1].toInt(&correct_format);
+		height = file_data[2].toInt(&correct_format);
+	}
+	while (!in.atEnd() && correct_format == true) {
+		//TYPE
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 2 || file_data[0] != "TYPE") {
+			correct_format = false;
+		}
+		QString object_type = file_data[1].trimmed().toLower();
+		//NAME
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 2 || file_data[0] != "NAME") {
+			correct_format = false;
+		}
+		QString object_name = file_data[1].trimmed();
+		//OUTLINE_COLOR
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 4 || file_data[0] != "OUTLINE_COLOR") {
+			correct_format = false;
+		}
+		if (!std::all_of(file_data.begin() + 1, file_data.end(), [](QString string) {
+			bool ok;
+			string.toInt(&ok);
+			return ok;
+			})) {
+			correct_format = false;
+		}
+		QColor object_outline_color = QColor(file_data[1].toInt(), file_data[2].toInt(), file_data[3].toInt());
+		//FILLING_COLOR
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 4 || file_data[0] != "FILLING_COLOR") {
+			correct_format = false;
+		}
+		if (!std::all_of(file_data.begin() + 1, file_data.end(), [](QString string) {
+			bool ok;
+			string.toInt(&ok);
+			return ok;
+			})) {
+			correct_format = false;
+		}
+		QColor object_filling_color = QColor(file_data[1].toInt(), file_data[2].toInt(), file_data[3].toInt());
+		//FILLING_ALG
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 2 || file_data[0] != "FILLING_ALG") {
+			correct_format = false;
+		}
+		int object_filling_alg = file_data[1].toInt(&correct_format);
+		//CURVE_TYPE
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 2 || file_data[0] != "CURVE_TYPE") {
+			correct_format = false;
+		}
+		int object_curve_type = file_data[1].toInt(&correct_format);
+		//LAYER
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 2 || file_data[0] != "LAYER") {
+			correct_format = false;
+		}
+		int object_layer = file_data[1].toInt(&correct_format);
+		//POINTS
+		file_line = in.readLine();
+		file_data = file_line.split(":");
+		if (file_data.length() != 2 || file_data[0] != "POINTS") {
+			correct_format = false;
+		}
+		int object_points_count = file_data[1].toInt(&correct_format);
+		if ((object_type == "line" || object_type == "circle" || object_type == "ellipse") && object_points_count != 2) {
+			correct_format = false;
+		}
+		QVector<QPair<QPoint, QPoint>> object_curve_points = QVector<QPair<QPoint, QPoint>>();
+		QVector<QPoint> object_points = QVector<QPoint>();
+		for (int i = 0; i < object_points_count; i++) {
+			file_data = in.readLine().split(":");
+			if (object_type == "curve" && file_data.length() == 4) {
+				QPoint start(file_data[0].toInt(&correct_format), file_data[1].toInt(&correct_format));
+				if (!file_data[2].isEmpty() && !file_data[3].isEmpty()) {
+					QPoint end(file_data[2].toInt(&correct_format), file_data[3].toInt(&correct_format));
+					object_curve_points.append({ start,end });
+				}
+				else {
+					object_curve_points.append({ start,QPoint() });
+				}
+			}
+			else if (file_data.length() == 2) {
+				QPoint point(file_data[0].toInt(&correct_format), file_data[1].toInt(&correct_format));
+				object_points.append(point);
+			}
+		}
+		file_line = in.readLine();
+		if (!file_line.trimmed().isEmpty()) {
+			correct_format = false;
+			break;
+		}
+		Object2D object = Object2D();
+		object.type = object_type;
+		object.name = object_name;
+		object.color_outline = object_outline_color;
+		object.color_filling = object_filling_color;
+		object.filling_alg = object_filling_alg;
+		object.curve_type = object_curve_type;
+		object.layer_height = object_layer;
+		object.curve_points = object_curve_points;
+		object.points = object_points;
+
+		objects.insert(object.name, object);
+
+	}
+	size = QSize(width, height);
+	return correct_format;
+}
+void rotateCubeAnimation(double d, int frames) {
+	QVector<Vertex> vertices = {
+		Vertex(0, 0, 0),Vertex(0, d, 0),Vertex(d, d, 0),Vertex(d, 0, 0),
+		Vertex(0,0,d), Vertex(0,d,d),Vertex(d,d,d), Vertex(d,0,d) };
+	double alphaIncrement = 2 * M_PI / frames;
+	double alpha = 0;
+	auto rotatePoints = [](double alpha, QVector<Vertex> vertices)->QVector<Vertex> {
+		for (Vertex& vertex : vertices) {
+			vertex.y *= (cos(alpha) + sin(alpha));
+			vertex.z *= (cos(alpha) - sin(alpha));
+		}
+		return vertices;
+		};
+	for (int frame = 0; frame < frames; frame++) {
+		createCubeVTK(rotatePoints(alpha, vertices), "cubeAnimationFrame" + QString::number(frame));
+	}
+}
+
+void writeUvSphereVTK(QTextStream& out, double r, int longitude, int latitude, int mode) {
+	QVector<QVector<Vertex>> vertices;
+	double thetaAngle = -M_PI/2;
+	double phiAngle = 0;
+	double rho = r;
+
+	double thetaAngleDivision = M_PI / latitude;
+	double phiAngleDivision = 2 * M_PI / longitude;
+
+	int verticesCount = 0;
+	for (int i = 0; i <= latitude; i++) {
+		QVector<Vertex> verticesOneLatitude;
+		for (int j = 0; j <= longitude; j++) {
+			Vertex vertex;
+			if (mode == 0) {
+				vertex.x = rho * cos(thetaAngle) * cos(phiAngle);
+				vertex.y = rho * cos(thetaAngle) * sin(phiAngle);
+				vertex.z = rho * sin(thetaAngle);
+			}
+			else if (mode == 1) {
+				vertex.x = 200 * cos(thetaAngle) * cos(phiAngle);
+				vertex.y = 100 * cos(thetaAngle) * sin(phiAngle);
+				vertex.z = 80 * sin(thetaAngle);
+			}
+			verticesOneLatitude.append(vertex);
+			phiAngle += phiAngleDivision;
+			verticesCount++;
+			if (i == 0 || i == latitude) {
+				break;
+			}
+		}
+		vertices.append(verticesOneLatitude);
+		phiAngle = 0;
+		thetaAngle += thetaAngleDivision;
+	}
+	out << VTK_FILE_HEADER;
+	out << "POINTS " <<  verticesCount << " float\n";
+	for (int i = 0; i < vertices.length(); i++) {
+		for (const Vertex& vertex : vertices[i]) {
+			out << vertex.x << " " << vertex.y << " " << vertex.z << "\n";
+		}
+	}
+	out << "POLYGONS " << 2 * (longitude * latitude) - 2  << " " << 4 * (2 * (longitude * latitude) - 2) << "\n";
+	int polygonCount = 0;
+	for (int i = 0; i < vertices[1].length(); i++) {
+		if (i < vertices[1].length() - 1) {
+			out << "3 0 " << i + 1 << " " << i + 2 << "\n";
+		}
+		else {
+			out << "3 0 " << i + 1 << " 1\n";
+		}
+		polygonCount++;
+	}
+	int itteratedVertices = 0;
+	int itteratedVerticesNext = 0;
+	for (int i = 1; i < vertices.length() - 2; i++) {
+		itteratedVertices += vertices[i - 1].length();
+		itteratedVerticesNext = itteratedVertices + vertices[i].length();
+		for (int j = 0; j < vertices[i].length(); j++) {
+			if (j < vertices[i].length() - 1) {
+				out << "3 " << itteratedVertices + j << " " << itteratedVerticesNext + j << " " << itteratedVerticesNext + j + 1 << "\n";
+				out << "3 " << itteratedVertices + j << " " << itteratedVerticesNext + j + 1 << " " << itteratedVertices + j + 1 << "\n";
+				polygonCount += 2;
+			}
+			else {
+				out << "3 " << itteratedVertices + j << " " << itteratedVerticesNext + j << " " << itteratedVerticesNext << "\n";
+				out << "3 " << itteratedVertices + j << " " << itteratedVerticesNext << " " << itteratedVertices << "\n";
+				polygonCount += 2;
+			}
+		}
+	}
+	itteratedVertices += vertices[1].length();
+	itteratedVerticesNext = verticesCount - 1;
+	for (int j = 0; j < vertices[1].length(); j++) {
+		if (j < vertices[1].length() - 1) {
+			out << "3 " << itteratedVertices + j << " " << itteratedVerticesNext << " " << itteratedVertices + j + 1 << "\n";
+		}
+		else {
+			out << "3 " << itteratedVertices + j << " " << itteratedVerticesNext << " " << itteratedVertices + j << "\n";
+		}
+		polygonCount++;
+	}
+}
+void createUvSphereVTK(double r, int longitude, int latitude, const QString& filename, int mode) {
+	QFile file(filename + ".vtk");
+	if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+		QTextStream out(&file);
+		writeUvSphereVTK(out, r, longitude, latitude, mode);
+		out.flush();
+		file.close();
+		qDebug() << "file was saved succsesfully";
+	}
+	else {
+		qDebug() << "file wasnt opened succsesfully";
+	}
+}
+
+//---------------------------------------------------------------------
\ No newline at end of file
@@ -0,0 +1,526 @@
+#pragma once
+
+#include <QImage>
+#include <QPainter>
+#include <QColor>
+#include <QRect>
+#include <QVector>
+#include <QVector3D>
+#include <QHash>
+#include <QDebug>
+#include <algorithm>
+#include <QPoint>
+#include <QString>
+#include <iostream>
+#include <cmath>
+#include <QMap>
+#include <array>
+#include <tuple>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include "RasterTarget.h"
+#include "RenderBatch.h"
+#include "FrameProfiler.h"
+#include "VertexCache.h"
+#include "ParallelFor.h"
+#include "HalfEdge.h"
+#include "Scene3D.h"
+#include "BspTree.h"
+
+//--------Need separated header for this classes---------------
+class Camera {
+public:
+	Vertex position;
+
+	Camera() {};
+	Camera(Vertex pos) :position(pos) {};
+
+};
+
+class ProjectionPlane {
+public:
+	double azimut = 0;
+	double zenit = 0;
+	Vertex normalVector = Vertex(0, 0, 0);
+	//Basis vectors for projection Coordinate System
+	Vertex basisVectorN = Vertex(0, 0, 0);
+	Vertex basisVectorU = Vertex(0, 0, 0);
+	Vertex basisVectorV = Vertex(0, 0, 0);
+	ProjectionPlane() {};
+	ProjectionPlane(double az, double zen, Vertex vectorNormal) :
+		azimut(az), zenit(zen), normalVector(vectorNormal) {
+		basisVectorN = Vertex(sin(zenit) * sin(azimut), sin(zenit) * cos(azimut), cos(zenit));
+		basisVectorU = Vertex(sin(zenit + M_PI / 2) * sin(azimut), sin(zenit + M_PI / 2) * cos(azimut), cos(zenit + M_PI / 2));
+		basisVectorV.x = basisVectorN.y * basisVectorU.z - basisVectorN.z * basisVectorU.y;
+		basisVectorV.y = basisVectorN.z * basisVectorU.x - basisVectorN.x * basisVectorU.z;
+		basisVectorV.z = basisVectorN.x * basisVectorU.y - basisVectorN.y * basisVectorU.x;
+	};
+	void setProjectionPlane(double az, double zen) {
+		azimut = az;
+		zenit = zen;
+		basisVectorN = Vertex(sin(zenit) * sin(azimut), sin(zenit) * cos(azimut), cos(zenit));
+		basisVectorU = Vertex(sin(zenit + M_PI / 2) * sin(azimut), sin(zenit + M_PI / 2) * cos(azimut), cos(zenit + M_PI / 2));
+		basisVectorV.x = basisVectorN.y * basisVectorU.z - basisVectorN.z * basisVectorU.y;
+		basisVectorV.y = basisVectorN.z * basisVectorU.x - basisVectorN.x * basisVectorU.z;
+		basisVectorV.z = basisVectorN.x * basisVectorU.y - basisVectorN.y * basisVectorU.x;
+	}
+};
+
+class LightSettings {
+public:
+	Vertex lightPosition = Vertex();
+	//coeficients for reflection, difusion, ambient
+	double rs = 0, rd = 0, ra = 0;
+	//mirror reflection sharpness
+	int h = 0; 
+	//Intesity of incident ligt ray (color)
+	QColor lightIntesity = QColor(0,0,0);
+	QColor lightIntesityAmbient = QColor(0,0,0);
+	LightSettings() {};
+	LightSettings(Vertex lightPos, double r_s, double r_d, double r_a, int h, QColor IL, QColor ILA) :lightPosition(lightPos), rs(r_s), rd(r_d), 
+		ra(r_a), h(h),lightIntesity(IL), lightIntesityAmbient(ILA) {};
+
+};
+//-------------------------------------------------------------
+
+class Object2D {
+public:
+	QString type = "";
+	QString name = "";
+	QVector<QPoint> points = QVector<QPoint>();
+	QVector<QPair<QPoint, QPoint>> curve_points = QVector<QPair<QPoint, QPoint>>();
+	int curve_type = 0;
+	QColor color_outline = Qt::white;
+	QColor color_filling = Qt::white;
+	int filling_alg = 0;
+	int layer_height = 0;
+	//Curve cache, flattened polyline of every segment, only invalidated segments are tessellated again
+	mutable QVector<QVector<QPointF>> curve_segment_polylines = QVector<QVector<QPointF>>();
+	mutable QVector<bool> curve_segment_valid = QVector<bool>();
+	mutable double curve_cache_tolerance = 0;
+	//Line / Circle
+	Object2D(QString type, QString name, QVector<QPoint> points, QColor color_outline,int layer_height) : type(std::move(type)), name(std::move(name)), points(std::move(points)), color_outline(color_outline),layer_height(layer_height) {};
+	//Polygon
+	Object2D(QString type, QString name, QVector<QPoint> points, QColor color_outline, QColor color_filling, int filling_alg, int layer_height ):type(std::move(type)), name(std::move(name)), points(std::move(points)), color_outline(color_outline), 
+		color_filling(color_filling),filling_alg(filling_alg), layer_height(layer_height) {};
+	//Curve
+	Object2D(QString type,QString name, QVector<QPair<QPoint, QPoint>> curve_points, QColor color_outline , int curve_type, int layer_height) : type(std::move(type)), name(std::move(name)), curve_points(std::move(curve_points)),
+		color_outline(color_outline),curve_type(curve_type), layer_height(layer_height) {};
+	Object2D() {};
+	//Hermite has segment between every two points, Bezier is one global segment, Coons has segment for every four consecutive points
+	int curveSegmentCount() const {
+		int n = curve_points.length();
+		if (curve_type == 0) {
+			return std::max(n - 1, 0);
+		}
+		else if (curve_type == 1) {
+			return n >= 2 ? 1 : 0;
+		}
+		return std::max(n - 3, 0);
+	}
+	//Marks segments which shape depends on control point with given index
+	void invalidateCurveSegments(int pointIndex) {
+		int first = 0;
+		int last = curve_segment_valid.length() - 1;
+		if (curve_type == 0) {
+			first = pointIndex - 1;
+			last = pointIndex;
+		}
+		else if (curve_type == 2) {
+			first = pointIndex - 3;
+			last = pointIndex;
+		}
+		for (int i = std::max(first, 0); i <= std::min(last, static_cast<int>(curve_segment_valid.length()) - 1); i++) {
+			curve_segment_valid[i] = false;
+		}
+	}
+	void invalidateCurve() { curve_segment_valid.fill(false); }
+};
+
+//2D scene state, same format as scene files saved by viewer
+bool readSceneState(QTextStream& in, QSize& size, QMap<QString, Object2D>& objects);
+
+//Reads instances in MODELVIEWER INSTANCES FORMAT, one instance per line "x y z rotationX rotationY rotationZ scale [#rrggbb]",
+//angles are in degrees, returns false when file doesn't match it
+bool readInstances(QTextStream& in, QVector<ObjectInstance>& instances);
+
+//Reads scene in MODELVIEWER ASSEMBLY FORMAT, one object per line "file.vtk x y z rotationX rotationY rotationZ scale [#rrggbb]",
+//files are relative to directory, every file is loaded once, returns false when file doesn't match it
+bool readAssembly(QTextStream& in, const QString& directory, Scene3D& scene);
+
+//Edge of scanline filler, x and its step per scanline are in 16.16 fixed point
+struct ScanlineEdge {
+	int yTop = 0;
+	int yBottom = 0;
+	qint64 x = 0;
+	qint64 dx = 0;
+	int winding = 1;
+};
+
+//Wireframe edge in screen coordinates, already clipped, depth is kept for hidden-line removal
+struct WireSegment {
+	QPoint start;
+	QPoint end;
+	double zStart = 0;
+	double zEnd = 0;
+};
+
+//View which projected vertices were computed for, they are reused until any part of it changes
+struct ProjectionKey {
+	const void* object = nullptr;
+	int vertexCount = 0;
+	int projectionType = -1;
+	double azimut = 0;
+	double zenit = 0;
+	double cameraZ = 0;
+	QSize imageSize;
+	bool operator==(const ProjectionKey& key) const {
+		return object == key.object && vertexCount == key.vertexCount && projectionType == key.projectionType &&
+			azimut == key.azimut && zenit == key.zenit && cameraZ == key.cameraZ && imageSize == key.imageSize;
+	}
+};
+
+//Triangle of surface pass which survived culling, colors are colors of its vertices after shading
+struct SurfaceTriangle {
+	std::array<Vertex*, 3> vertices;
+	std::array<QColor, 3> colors;
+};
+
+//Half of surface triangle after setup, vertices are sorted by y and one of its edges is horizontal
+struct SurfaceHalf {
+	std::array<Vertex, 3> vertices;
+	int triangle = 0;
+};
+
+//Pass of surface drawing, depth prepass writes only depth and pass after it shades only pixels at that depth,
+//triangles ordered back to front are drawn without depth buffer
+enum class SurfacePass { Single, Depth, AfterDepth, NoDepth };
+
+//Pass of wireframe drawing with hidden lines removed, single object resets Z-buffer and draws depth of its faces before its lines.
+//Objects of scene and copies of object first all draw depth of their faces into one Z-buffer, then all draw lines against it
+enum class WirePass { Single, Depth, Lines };
+
+//Position of primitive's bounding box against image
+enum class ClipResult { Inside, Partial, Outside };
+
+//Rendering of 2D scenes and 3D objects into off-screen image, needs no windowing system,
+//image is either owned or wraps caller's buffer of 32-bit ARGB pixels
+class Renderer {
+private:
+	QImage* img = nullptr;
+	QPainter* painter = nullptr;
+	uchar* data = nullptr;
+	RasterTarget target;
+
+	Camera camera = Camera(Vertex(0,0,0));
+	ProjectionPlane projectionPlane = ProjectionPlane(0,0,Vertex(0,0,0));
+
+	//Depth buffer of Z-buffer algorithm, allocated once per image size and reset in place
+
+	QVector<double> z_buffer_layer_array;
+
+	//maximal distance in pixels between curve and its drawn polyline
+	double curveTolerance = 0.25;
+
+	bool croppedBySutherlandHodgman = false;
+
+	Object_H_edge currentObject = Object_H_edge();
+
+	//Scratch buffers reused between redraws so steady-state drawing doesn't allocate
+	QVector<Vertex> savedVertices;
+	QVector<QPoint> curveControlPoints;
+	QVector<QPointF> curvePolyline;
+	QVector<QPointF> curveSubdivisionBuffer;
+	QVector<QPoint> clipPolygonBuffer;
+	QVector<ScanlineEdge> scanlineEdges;
+	QVector<ScanlineEdge> bucketedEdges;
+	QVector<int> edgeBucketStart;
+	QVector<int> edgeBucketFill;
+	QVector<QVector<ScanlineEdge>> bandActiveEdges;
+	//0 - even-odd, 1 - non-zero winding
+	int polygonFillRule = 0;
+
+	//Anti-aliasing with analytic coverage, lines and circles by Wu, solid polygons by coverage accumulation
+	bool antialiasing = false;
+	QVector<float> coverageBuffer;
+	QVector<int> shapeHalfWidths;
+	QVector<QPointF> clipPolygonBufferF;
+	QVector<QPointF> clipPolygonBufferBackF;
+
+	//Command buffer reused for curves, 2D scene and wireframe, rasterizers don't post update while batch is submitted
+	RenderBatch renderBatch;
+	QVector<int> batchOrder;
+	QVector<QPoint> batchPolygon;
+	bool batchSubmitting = false;
+
+	//Worker threads of parallel fills, rasterization and sorting, kept for lifetime of renderer, clusters and bands are handed to them
+	WorkerPool workers;
+
+	//Wireframe, projected vertices are cached between frames, segments are rebuilt from unique edge list of object
+	QVector<Vertex> projectedVertices;
+	ProjectionKey projectedVerticesKey;
+	QVector<WireSegment> wireSegments;
+	bool hiddenLineRemoval = false;
+
+	//Surface is drawn by clusters of object, visible clusters are handed to threads in batches,
+	//every thread runs cull, shade and setup pass over its run of clusters, then bands of rows rasterize them
+	QVector<const Meshlet*> visibleMeshlets;
+	QVector<QVector<SurfaceTriangle>> chunkTriangles;
+	QVector<QVector<SurfaceHalf>> chunkHalves;
+	QVector<int> bandShaded;
+	QVector<int> bandZTestFailed;
+	//clusters facing away are skipped only on request, back faces of closed object cover pixels between its front triangles left by filler
+	bool backFaceCulling = false;
+	QVector<QRect> chunkBounds;
+	QVector<int> chunkOccluded;
+	QVector<int> bandBlockRejected;
+
+	//Hierarchical depth, level 0 keeps farthest depth of every 8x8 tile of Z-buffer and every next level farthest of 2x2 tiles below it.
+	//It is refreshed after every rasterized batch, so later clusters and objects are tested against what is already drawn
+	bool occlusionCulling = true;
+	QVector<QVector<double>> hiZLevels;
+	QVector<QSize> hiZSizes;
+	//Visible clusters may be sorted front to back by quantized depth and drawn after depth prepass, both only change order of work
+	bool frontToBack = false;
+	bool depthPrepass = false;
+	QVector<double> meshletDepths;
+	QVector<quint32> meshletKeys;
+	QVector<quint32> meshletKeysScratch;
+	QVector<const Meshlet*> visibleMeshletsScratch;
+	//digit offsets of every chunk of radix sort, shared by cluster and triangle sorting
+	QVector<std::array<int, 256>> radixOffsets;
+
+	//Surface without depth buffer, 0 - Z-buffer, 1 - painter's algorithm, 2 - BSP tree, taken from representation of drawn frame.
+	//Buffers of other modes are released when frame starts, so only memory of used mode is held
+	int surfaceVisibility = 0;
+	//pass of wireframe, scene and copies of object set it while they draw
+	WirePass wirePass = WirePass::Single;
+	//painter's algorithm sorts triangles by depth of their centroids quantized to 24 bits, farthest first
+	QVector<SurfaceTriangle> orderedTriangles;
+	QVector<double> triangleDepths;
+	//smallest and largest depth of every sorting chunk
+	QVector<QPair<double, double>> triangleDepthRanges;
+	QVector<quint32> triangleKeys;
+	QVector<quint32> triangleKeysScratch;
+	QVector<int> triangleOrder;
+	QVector<int> triangleOrderScratch;
+	//BSP trees are built once per drawn mesh, only vertices made by splits are projected every frame
+	QHash<const Object_H_edge*, BspTree> bspTrees;
+	QVector<Vertex> bspProjected;
+	QVector<int> bspStack;
+
+	//Copies of current object, scratch buffers are sized by its mesh, not by number of copies
+	QVector<ObjectInstance> instances;
+	QVector<InstanceTransform> instanceTransforms;
+	QVector<int> instanceOrder;
+	//depth of center and position in orientation order of every copy, sort keys of back to front order
+	QVector<double> instanceDepths;
+	QVector<int> instanceRanks;
+	QVector<Vertex> instanceViewVertices;
+	QVector<Vertex> instanceVertices;
+
+	//Scene of many objects, drawn instead of current object when it isn't empty
+	Scene3D scene;
+	QVector<int> sceneVisible;
+	QVector<QPair<double, int>> sceneOrder;
+
+	FrameProfiler profiler;
+
+	//Level of detail of current object, simplified copies from finest to coarsest are built in background thread after object is set
+	bool levelOfDetail = true;
+	bool interactive = false;
+	QVector<Object_H_edge> lodLevels;
+	QVector<Object_H_edge> lodPending;
+	bool lodPendingReady = false;
+	std::mutex lodMutex;
+	std::thread lodThread;
+	std::atomic<bool> lodCancel{ false };
+	//bounding sphere of current object, its projected size decides level
+	Vertex currentObjectCenter;
+	double currentObjectRadius = 0;
+
+	void stopLevelOfDetail();
+
+protected:
+	//Called with area of image which was redrawn, display wrapper schedules repaint of it
+	virtual void imageChanged(const QRect& /*region*/) {}
+
+public:
+	Renderer(QSize imgSize = QSize(0, 0));
+	Renderer(uchar* buffer, int width, int height, qsizetype bytesPerLine);
+	Renderer(const Renderer&) = delete;
+	Renderer& operator=(const Renderer&) = delete;
+	virtual ~Renderer();
+
+	//Get/Set functions
+	uchar* getData() { return data; }
+	void setDataPtr() { data = img->bits(); target.attach(img); }
+	void setPainter() { painter = new QPainter(img); }
+	int getImgWidth() { return img->width(); };
+	int getImgHeight() { return img->height(); };
+	//CAMERA & PROJECTION PLANE
+	ProjectionPlane& getProjectionPlane() { return projectionPlane; }
+	Camera& getCamera() { return camera; }
+	void setCurveTolerance(double tolerance) { curveTolerance = tolerance; }
+	double getCurveTolerance() { return curveTolerance; }
+	void setPolygonFillRule(int fillRule) { polygonFillRule = fillRule; }
+	void setAntialiasing(bool state) { antialiasing = state; }
+	bool getAntialiasing() { return antialiasing; }
+	int getPolygonFillRule() { return polygonFillRule; }
+	void setHiddenLineRemoval(bool state) { hiddenLineRemoval = state; }
+	bool getHiddenLineRemoval() { return hiddenLineRemoval; }
+	void setBackFaceCulling(bool state) { backFaceCulling = state; }
+	bool getBackFaceCulling() { return backFaceCulling; }
+	void setOcclusionCulling(bool state) { occlusionCulling = state; }
+	bool getOcclusionCulling() { return occlusionCulling; }
+	void setFrontToBack(bool state) { frontToBack = state; }
+	bool getFrontToBack() { return frontToBack; }
+	void setDepthPrepass(bool state) { depthPrepass = state; }
+	bool getDepthPrepass() { return depthPrepass; }
+	//THREADS of parallel drawing including calling thread, 0 takes all cores, renderers running in parallel set 1 so cores aren't oversubscribed
+	void setThreadCount(int count) { workers.setThreadCount(count); }
+	int getThreadCount() const { return workers.threadCount(); }
+	//PROFILER, frames of 3D object are profiled when enabled
+	FrameProfiler& getProfiler() { return profiler; }
+
+	//3D OBJECT
+	void setCurrentObject(Object_H_edge&& object);
+	//LEVEL OF DETAIL, coarse level is drawn during interaction
+	void setLevelOfDetail(bool state) { levelOfDetail = state; }
+	bool getLevelOfDetail() { return levelOfDetail; }
+	void setInteractive(bool state) { interactive = state; }
+	bool getInteractive() { return interactive; }
+	//Level used instead of current object, other objects are drawn as they are
+	const Object_H_edge& selectLevelOfDetail(const Object_H_edge& object, int projectionType);
+	//Drops cached projected vertices, needed when other object than current one is drawn
+	void invalidateProjection() { projectedVerticesKey = ProjectionKey(); }
+	const Object_H_edge& getCurrentObject() const { return currentObject; }
+	//INSTANCES, when set current object is drawn once for every instance instead of once in place
+	void setInstances(QVector<ObjectInstance> objectInstances) { instances = std::move(objectInstances); }
+	const QVector<ObjectInstance>& getInstances() const { return instances; }
+	//SCENE, loading new object clears it
+	Scene3D& getScene() { return scene; }
+	//Nearest scene object whose projected bounding sphere contains position, -1 when there is none
+	int pickSceneObject(const QPoint& position, int projectionType);
+	//Moves scene object in plane of view so its center follows delta in image, hierarchy is refit by Scene3D::setPlacement
+	void moveSceneObject(int object, const QPoint& delta, int projectionType);
+	//Vertex-cache reordering of current object, its simplified levels are left as they are
+	VertexCacheReport optimizeCurrentObject();
+
+
+	//Image functions
+	bool setImage(const QImage& inputImg);
+	QImage* getImage() { return img; };
+	bool isEmpty();
+	bool changeSize(int width, int height);
+
+	void setPixel(int x, int y, uchar r, uchar g, uchar b, uchar a = 255);
+	void setPixel(int x, int y, double valR, double valG, double valB, double valA = 1.);
+	void setPixel(int x, int y, const QColor& color);
+	//Pixel and span writes of 2D fillers, coordinates are already clamped
+	void plotPixel(int x, int y, QRgb color);
+	void plotSpan(int y, int x0, int x1, QRgb color);
+	//coverage 0..256, partially covered pixel is blended into image
+	void plotPixelCoverage(int x, int y, QRgb color, int coverage);
+	bool isInside(int x, int y) { return (x >= 0 && y >= 0 && x < img->width() && y < img->height()) ? true : false; }
+	//Guard band is image extended by its own size on every side, primitives inside it skip clipping and rasterizers clamp them to image
+	QRect guardBand() { return QRect(-img->width(), -img->height(), 3 * img->width(), 3 * img->height()); }
+	bool isInsideGuardBand(const QRect& boundingBox) { return guardBand().contains(boundingBox); }
+	void resetZBuffer();
+	//Starts surface frame of current visibility mode, Z-buffer is reset or released
+	void beginSurfaceFrame();
+	//Bytes held by visibility of surface in current mode
+	qint64 visibilityMemory() const;
+	void requestUpdate() {
+		if (!batchSubmitting) {
+			imageChanged(img->rect());
+		}
+	}
+
+	//Draw functions
+	//2D draw functions
+	void drawLine(QPoint start, QPoint end, const QColor& color, int algType = 0);
+	void drawLineDDA(QPoint start, QPoint end, const QColor& color);
+	void drawLineBresenham(QPoint start, QPoint end, const QColor& color);
+	void drawCircleBresenham(QPoint start, QPoint end, const QColor& color);
+	//Circle and ellipse engine, shapes fully inside image are drawn without bounds checks, filled shapes are written as spans,
+	//update of image is requested by caller (batch submits one dirty region)
+	void drawCircle(QPoint center, int r, const QColor& color, bool filled = false);
+	void drawEllipse(QPoint center, int rx, int ry, const QColor& color, bool filled = false);
+	ClipResult classifyBoundingBox(const QRect& boundingBox);
+	void plotClampedSpan(int y, int x0, int x1, QRgb color);
+	void drawLineWu(QPoint start, QPoint end, const QColor& color);
+	void drawCircleWu(QPoint center, double r, const QColor& color);
+	void fillPolygonCoverage(const QVector<QPoint>& points, const QColor& color);
+	void drawPolygon(const QVector<QPoint>& points, const QColor& color, int algType = 0, int fillingAlgType = 0);
+	void scanLinePolygon(const QVector<QPoint>& points, const QColor& color);
+	void fillTriangleSetup(const QVector<QPoint>& points, const QColor& color, int fillAlgType);
+	void fillTriangle(const std::array<QPoint, 3>& currentPoints, const QVector<QPoint>& oldPoints, QColor color, int fillAlgType);
+	QColor fillTriangleNearestNeighbour(const QVector<QPoint>& points, QPoint currentPoint, const std::array<QColor, 3>& colors);
+	QColor fillTriangleBaricentric(const QVector<QPoint>& points, QPoint currentPoint, const std::array<QColor, 3>& colors);
+	void drawCurve(const QVector<QPair<QPoint, QPoint>>& points, const QColor& color, int algType);
+	void drawCurveHermint(const QVector<QPair<QPoint, QPoint>>& points, const QColor& color);
+	void drawCurveCasteljau(const QVector<QPoint>& points, const QColor& color);
+	void drawCurveCoons(const QVector<QPoint>& points, const QColor& color);
+	void recordCurveObject(const Object2D& object, RenderBatch& batch);
+	void recordCurveControlPoints(const QVector<QPair<QPoint, QPoint>>& points, int algType, int layer, RenderBatch& batch);
+
+	void drawObjects2D(const QMap<QString,Object2D>& objects);
+	//Draws recorded commands sorted by layer, clipping is decided once per command and one update is posted for union of their areas
+	void submitBatch(const RenderBatch& batch);
+
+	//3D draw functions
+	//object is seen by camera and projection plane of renderer (getCamera, getProjectionPlane)
+	void drawObject(const Object_H_edge& object, int projectionType, int representationType,int fillingAlgType, const LightSettings* ls);
+	Vertex projectVertex(const Vertex& vertex, int projectionType);
+	void perspectiveCoordSystemTransformation(const Object_H_edge& object, int projectionType, QVector<Vertex>& oldVertices);
+	const QVector<Vertex>& projectVertices(const Object_H_edge& object, int projectionType);
+	//Wireframe from unique edges, bands of rows are drawn in parallel, hidden lines are optionally removed by depth of faces
+	void drawWireframe(const Object_H_edge& object, int projectionType);
+	void drawWireframeVertices(const Object_H_edge& object, const QVector<Vertex>& projected);
+	//Surface of object whose vertices are already in projection coordinates, Z-buffer is reset by caller so several objects may share it
+	void drawSurface(const Object_H_edge& object, int projectionType, int fillingAlgType, const LightSettings* ls, const InstanceTransform* instance = nullptr, const QColor& color = QColor());
+	//Surface drawn back to front without depth buffer, triangles are ordered by painter's algorithm or by BSP tree of object
+	void drawSurfaceOrdered(const Object_H_edge& object, int projectionType, int fillingAlgType, const LightSettings* ls, const InstanceTransform* instance, const QColor& color);
+	//Shades, sets up and rasterizes triangles of chunks, bands draw chunks in their order
+	void rasterizeChunks(int chunkCount, const LightSettings* ls, int fillingAlgType, SurfacePass pass);
+	//Copies of object, bounds of every copy are culled on their own and copies with same orientation share transformed vertices
+	void drawInstances(const Object_H_edge& object, int projectionType, int representationType, int fillingAlgType, const LightSettings* ls);
+	//Objects of scene not culled by walk over its hierarchy, front to back into one Z-buffer
+	void drawScene(int projectionType, int representationType, int fillingAlgType, const LightSettings* ls);
+	//Rotates and scales saved vertices into view coordinates (translation is left for drawViewVertices)
+	void computeViewVertices(const InstanceTransform& transform);
+	//Translates and projects view vertices, then draws object from them
+	void drawViewVertices(const Object_H_edge& object, const InstanceTransform& transform, const QColor& color, int projectionType, int representationType, int fillingAlgType, const LightSettings* ls);
+	void profileCoveredPixels();
+	bool isSphereOutsideImage(const Vertex& center, double radius, int projectionType);
+	//Box of sphere in image and depth of its nearest point, false when sphere reaches behind camera
+	bool sphereScreenBounds(const Vertex& center, double radius, int projectionType, double& xMin, double& xMax, double& yMin, double& yMax, double& zMax);
+	//True when sphere lies behind everything drawn in its box of image
+	bool isSphereOccluded(const Vertex& center, double radius, int projectionType);
+	bool isBoxOccluded(double xMin, double xMax, double yMin, double yMax, double zMax);
+	//Radix sort of visible clusters by depth of their nearest points quantized to 16 bits, nearest first
+	void sortMeshletsFrontToBack(int projectionType, const InstanceTransform* instance);
+	void resetHierarchicalDepth();
+	//Recomputes tiles of all levels over region of image from Z-buffer
+	void refreshHierarchicalDepth(const QRect& region);
+	void drawWireSegment(const WireSegment& segment, int bandBegin, int bandEnd, QRgb color, bool depthTest, double bias);
+	double baricentricInterpolation(const QVector<Vertex*>& vertices, Vertex* currentVertex);
+	QColor phongLightingModel(const Vertex& vertex, const LightSettings& ls);
+	//Splits triangle into halves with horizontal edge, returns their count
+	int setupObjectTriangle(const std::array<Vertex*, 3>& vertices, int triangle, SurfaceHalf* halves);
+	//Fills rows bandBegin .. bandEnd - 1 of half, returns number of shaded pixels and adds pixels hidden by Z-buffer to zTestFailed,
+	//pixels in blocks skipped by hierarchical depth are added to blockRejected
+	int fillObjectPolygon(const std::array<const Vertex*, 3>& vertices, const std::array<Vertex*, 3>& oldVertices, const std::array<QColor, 3>& colors, bool usingLightSettings, int fillingAlg,
+		int bandBegin, int bandEnd, int& zTestFailed, int& blockRejected, SurfacePass pass = SurfacePass::Single);
+	//True when cluster lies outside of image or all its triangles face away from camera
+	bool isMeshletCulled(const Meshlet& meshlet, int projectionType, const InstanceTransform* instance = nullptr);
+
+
+
+	bool cyrusBeck(QPoint& P1, QPoint& P2);
+	const QVector<QPoint>& sutherlandHodgman(const QVector<QPoint>& V);
+
+	void clear();
+};
@@ -0,0 +1,145 @@
+#include "Scene3D.h"
+#include <algorithm>
+#include <cfloat>
+
+//Objects in leaf of hierarchy, bigger leaves make it shallower but test more spheres of objects
+static const int sceneLeafObjects = 4;
+
+int Scene3D::addMesh(Object_H_edge&& mesh) {
+	Vertex center;
+	double radius = 0;
+	if (!mesh.vertices.isEmpty()) {
+		Vertex minimum = *mesh.vertices[0];
+		Vertex maximum = minimum;
+		for (const Vertex* vertex : mesh.vertices) {
+			minimum = Vertex(std::min(minimum.x, vertex->x), std::min(minimum.y, vertex->y), std::min(minimum.z, vertex->z));
+			maximum = Vertex(std::max(maximum.x, vertex->x), std::max(maximum.y, vertex->y), std::max(maximum.z, vertex->z));
+		}
+		center = Vertex((minimum.x + maximum.x) / 2, (minimum.y + maximum.y) / 2, (minimum.z + maximum.z) / 2);
+		Vertex halfDiagonal(maximum.x - center.x, maximum.y - center.y, maximum.z - center.z);
+		radius = sqrt(halfDiagonal * halfDiagonal);
+	}
+	meshes.append(std::move(mesh));
+	meshCenters.append(center);
+	meshRadii.append(radius);
+	return meshes.length() - 1;
+}
+
+int Scene3D::addObject(int mesh, const ObjectInstance& placement) {
+	objectMeshes.append(mesh);
+	placements.append(placement);
+	objectCenters.append(Vertex());
+	objectRadii.append(0);
+	objectLeaves.append(-1);
+	updateObjectBounds(placements.length() - 1);
+	hierarchyValid = false;
+	return placements.length() - 1;
+}
+
+void Scene3D::setPlacement(int object, const ObjectInstance& placement) {
+	placements[object] = placement;
+	updateObjectBounds(object);
+	if (!hierarchyValid) {
+		return;
+	}
+	for (int node = objectLeaves[object]; node >= 0; node = nodes[node].parent) {
+		updateNodeBounds(node);
+	}
+}
+
+void Scene3D::clear() {
+	for (Object_H_edge& mesh : meshes) {
+		mesh.release();
+	}
+	meshes.clear();
+	meshCenters.clear();
+	meshRadii.clear();
+	objectMeshes.clear();
+	placements.clear();
+	objectCenters.clear();
+	objectRadii.clear();
+	nodes.clear();
+	nodeObjects.clear();
+	objectLeaves.clear();
+	hierarchyValid = false;
+}
+
+void Scene3D::updateObjectBounds(int object) {
+	//sphere keeps its radius under any rotation, only its center is transformed
+	InstanceTransform transform(placements[object]);
+	objectCenters[object] = transform.apply(meshCenters[objectMeshes[object]]);
+	objectRadii[object] = meshRadii[objectMeshes[object]] * std::abs(placements[object].scale);
+}
+
+void Scene3D::updateNodeBounds(int node) {
+	SceneNode& current = nodes[node];
+	if (!current.isLeaf()) {
+		const SceneNode& left = nodes[current.left];
+		const SceneNode& right = nodes[current.right];
+		current.minimum = Vertex(std::min(left.minimum.x, right.minimum.x), std::min(left.minimum.y, right.minimum.y), std::min(left.minimum.z, right.minimum.z));
+		current.maximum = Vertex(std::max(left.maximum.x, right.maximum.x), std::max(left.maximum.y, right.maximum.y), std::max(left.maximum.z, right.maximum.z));
+		return;
+	}
+	current.minimum = Vertex(DBL_MAX, DBL_MAX, DBL_MAX);
+	current.maximum = Vertex(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	for (int i = current.first; i < current.first + current.count; i++) {
+		const Vertex& center = objectCenters[nodeObjects[i]];
+		double radius = objectRadii[nodeObjects[i]];
+		current.minimum = Vertex(std::min(current.minimum.x, center.x - radius), std::min(current.minimum.y, center.y - radius), std::min(current.minimum.z, center.z - radius));
+		current.maximum = Vertex(std::max(current.maximum.x, center.x + radius), std::max(current.maximum.y, center.y + radius), std::max(current.maximum.z, center.z + radius));
+	}
+}
+
+int Scene3D::buildNode(int first, int count, int parent) {
+	int node = nodes.length();
+	nodes.append(SceneNode());
+	nodes[node].parent = parent;
+	nodes[node].first = first;
+	nodes[node].count = count;
+	if (count <= sceneLeafObjects) {
+		for (int i = first; i < first + count; i++) {
+			objectLeaves[nodeObjects[i]] = node;
+		}
+		updateNodeBounds(node);
+		return node;
+	}
+	//objects are split in half along longest side of box around their centers, so depth stays logarithmic
+	Vertex minimum(DBL_MAX, DBL_MAX, DBL_MAX);
+	Vertex maximum(-DBL_MAX, -DBL_MAX, -DBL_MAX);
+	for (int i = first; i < first + count; i++) {
+		const Vertex& center = objectCenters[nodeObjects[i]];
+		minimum = Vertex(std::min(minimum.x, center.x), std::min(minimum.y, center.y), std::min(minimum.z, center.z));
+		maximum = Vertex(std::max(maximum.x, center.x), std::max(maximum.y, center.y), std::max(maximum.z, center.z));
+	}
+	double sizeX = maximum.x - minimum.x, sizeY = maximum.y - minimum.y, sizeZ = maximum.z - minimum.z;
+	int axis = (sizeX >= sizeY && sizeX >= sizeZ) ? 0 : (sizeY >= sizeZ ? 1 : 2);
+	auto coordinate = [this, axis](int object) {
+		const Vertex& center = objectCenters[object];
+		return axis == 0 ? center.x : axis == 1 ? center.y : center.z;
+	};
+	int half = count / 2;
+	std::nth_element(nodeObjects.begin() + first, nodeObjects.begin() + first + half, nodeObjects.begin() + first + count,
+		[&coordinate](int a, int b) { return coordinate(a) < coordinate(b); });
+	int left = buildNode(first, half, node);
+	int right = buildNode(first + half, count - half, node);
+	nodes[node].left = left;
+	nodes[node].right = right;
+	updateNodeBounds(node);
+	return node;
+}
+
+void Scene3D::buildHierarchy() {
+	if (hierarchyValid) {
+		return;
+	}
+	nodes.resize(0);
+	nodeObjects.resize(placements.length());
+	for (int i = 0; i < placements.length(); i++) {
+		nodeObjects[i] = i;
+	}
+	if (!placements.isEmpty()) {
+		nodes.reserve(2 * placements.length() / sceneLeafObjects + 1);
+		buildNode(0, placements.length(), -1);
+	}
+	hierarchyValid = true;
+}
@@ -0,0 +1,151 @@
+#pragma once
+
+#include <QVector>
+#include <QColor>
+#include <array>
+#include <tuple>
+#include <cmath>
+#include "HalfEdge.h"
+
+//Copy of current object placed in scene, all copies share its mesh. Object is rotated about x, y and z axis (in this order),
+//then scaled and moved, angles are in radians
+struct ObjectInstance {
+	double rotationX = 0;
+	double rotationY = 0;
+	double rotationZ = 0;
+	double scale = 1;
+	Vertex translation;
+	//color of all faces of copy, invalid color keeps colors of faces
+	QColor color;
+
+	bool sameOrientation(const ObjectInstance& instance) const {
+		return rotationX == instance.rotationX && rotationY == instance.rotationY && rotationZ == instance.rotationZ && scale == instance.scale;
+	}
+	bool orientationLess(const ObjectInstance& instance) const {
+		return std::make_tuple(rotationX, rotationY, rotationZ, scale) < std::make_tuple(instance.rotationX, instance.rotationY, instance.rotationZ, instance.scale);
+	}
+};
+
+//Matrix of instance, rows of rotation are multiplied by scale
+struct InstanceTransform {
+	std::array<Vertex, 3> rows;
+	double scale = 1;
+	Vertex translation;
+
+	InstanceTransform() {}
+	InstanceTransform(const ObjectInstance& instance) : scale(instance.scale), translation(instance.translation) {
+		double sx = sin(instance.rotationX), cx = cos(instance.rotationX);
+		double sy = sin(instance.rotationY), cy = cos(instance.rotationY);
+		double sz = sin(instance.rotationZ), cz = cos(instance.rotationZ);
+		rows[0] = Vertex(cz * cy, cz * sy * sx - sz * cx, cz * sy * cx + sz * sx);
+		rows[1] = Vertex(sz * cy, sz * sy * sx + cz * cx, sz * sy * cx - cz * sx);
+		rows[2] = Vertex(-sy, cy * sx, cy * cx);
+		for (Vertex& row : rows) {
+			row = Vertex(row.x * scale, row.y * scale, row.z * scale);
+		}
+	}
+	Vertex apply(const Vertex& vertex) const {
+		return Vertex(rows[0] * vertex + translation.x, rows[1] * vertex + translation.y, rows[2] * vertex + translation.z);
+	}
+	//direction is only rotated
+	QVector3D rotate(const QVector3D& direction) const {
+		Vertex vertex(direction.x(), direction.y(), direction.z());
+		return QVector3D(rows[0] * vertex / scale, rows[1] * vertex / scale, rows[2] * vertex / scale);
+	}
+	//inverse of rotation and scale, rows are orthogonal and their length is scale
+	Vertex unrotate(const Vertex& direction) const {
+		double scale2 = scale * scale;
+		return Vertex((rows[0].x * direction.x + rows[1].x * direction.y + rows[2].x * direction.z) / scale2,
+			(rows[0].y * direction.x + rows[1].y * direction.y + rows[2].y * direction.z) / scale2,
+			(rows[0].z * direction.x + rows[1].z * direction.y + rows[2].z * direction.z) / scale2);
+	}
+	//point of world in coordinates of object
+	Vertex unapply(const Vertex& vertex) const {
+		return unrotate(Vertex(vertex.x - translation.x, vertex.y - translation.y, vertex.z - translation.z));
+	}
+};
+
+//Node of bounding volume hierarchy over world bounds of scene objects, leaf holds run of objects in order of hierarchy
+struct SceneNode {
+	Vertex minimum;
+	Vertex maximum;
+	int parent = -1;
+	int left = -1;
+	int right = -1;
+	int first = 0;
+	int count = 0;
+	bool isLeaf() const { return left < 0; }
+};
+
+//3D scene of many objects placed by their transforms, mesh loaded once is shared by every object placed from it.
+//Hierarchy is built over bounding spheres of objects in world, moved object only refits its leaf and nodes above it
+class Scene3D {
+private:
+	QVector<Object_H_edge> meshes;
+	//bounding sphere of every mesh in its own coordinates
+	QVector<Vertex> meshCenters;
+	QVector<double> meshRadii;
+	QVector<int> objectMeshes;
+	QVector<ObjectInstance> placements;
+	//bounding sphere of every object in world
+	QVector<Vertex> objectCenters;
+	QVector<double> objectRadii;
+	QVector<SceneNode> nodes;
+	QVector<int> nodeObjects;
+	QVector<int> objectLeaves;
+	bool hierarchyValid = false;
+
+	void updateObjectBounds(int object);
+	void updateNodeBounds(int node);
+	int buildNode(int first, int count, int parent);
+
+public:
+	int addMesh(Object_H_edge&& mesh);
+	int addObject(int mesh, const ObjectInstance& placement);
+	//Moves object, hierarchy is refit from its leaf up to root
+	void setPlacement(int object, const ObjectInstance& placement);
+	//Releases meshes of all objects
+	void clear();
+	bool isEmpty() const { return placements.isEmpty(); }
+	int objectCount() const { return placements.length(); }
+	int meshCount() const { return meshes.length(); }
+	Object_H_edge& objectMesh(int object) { return meshes[objectMeshes[object]]; }
+	const ObjectInstance& placement(int object) const { return placements[object]; }
+	const Vertex& objectCenter(int object) const { return objectCenters[object]; }
+	double objectRadius(int object) const { return objectRadii[object]; }
+	const QVector<SceneNode>& getNodes() const { return nodes; }
+	//objects in order of hierarchy, node holds run [first, first + count) of them
+	const QVector<int>& getNodeObjects() const { return nodeObjects; }
+	//Builds hierarchy when objects were added since last build
+	void buildHierarchy();
+	//Objects whose nodes are not rejected by outside(center, radius), node is tested by sphere around its box
+	template <typename Outside>
+	void collectVisible(Outside outside, QVector<int>& visible) const {
+		visible.resize(0);
+		if (nodes.isEmpty()) {
+			return;
+		}
+		int stack[64];
+		int stackSize = 0;
+		stack[stackSize++] = 0;
+		while (stackSize > 0) {
+			const SceneNode& node = nodes[stack[--stackSize]];
+			Vertex center((node.minimum.x + node.maximum.x) / 2, (node.minimum.y + node.maximum.y) / 2, (node.minimum.z + node.maximum.z) / 2);
+			Vertex halfDiagonal(node.maximum.x - center.x, node.maximum.y - center.y, node.maximum.z - center.z);
+			if (outside(center, sqrt(halfDiagonal * halfDiagonal))) {
+				continue;
+			}
+			if (node.isLeaf()) {
+				for (int i = node.first; i < node.first + node.count; i++) {
+					if (!outside(objectCenters[nodeObjects[i]], objectRadii[nodeObjects[i]])) {
+						visible.append(nodeObjects[i]);
+					}
+				}
+			}
+			else {
+				stack[stackSize++] = node.right;
+				stack[stackSize++] = node.left;
+			}
+		}
+	}
+};
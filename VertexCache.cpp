@@ -0,0 +1,143 @@
+#include "VertexCache.h"
+#include "Renderer.h"
+
+double averageCacheMissRatio(const QVector<int>& triangleIndices, int cacheSize) {
+	if (triangleIndices.length() < 3) {
+		return 0;
+	}
+	int maxIndex = *std::max_element(triangleIndices.begin(), triangleIndices.end());
+	//vertex is in FIFO while fewer than cacheSize misses happened after it was inserted
+	QVector<int> insertedAt(maxIndex + 1, -1);
+	int misses = 0;
+	for (int index : triangleIndices) {
+		if (insertedAt[index] < 0 || misses - insertedAt[index] >= cacheSize) {
+			insertedAt[index] = misses;
+			misses++;
+		}
+	}
+	return static_cast<double>(misses) / (triangleIndices.length() / 3);
+}
+
+VertexCacheReport optimizeVertexCache(Object_H_edge& object, int cacheSize) {
+	VertexCacheReport report;
+	report.acmrBefore = averageCacheMissRatio(object.triangle_indices, cacheSize);
+	const int faceCount = object.faces.length();
+	const int vertexCount = object.vertices.length();
+	if (faceCount == 0) {
+		report.acmrAfter = report.acmrBefore;
+		return report;
+	}
+	QHash<const Vertex*, int> vertexIndex;
+	vertexIndex.reserve(vertexCount);
+	for (int i = 0; i < vertexCount; i++) {
+		vertexIndex.insert(object.vertices[i], i);
+	}
+	//vertices of faces and faces around vertices in compressed rows
+	QVector<int> faceStart(faceCount + 1, 0);
+	QVector<int> faceVertices;
+	faceVertices.reserve(object.edges.length());
+	QVector<int> adjacencyStart(vertexCount + 1, 0);
+	for (int f = 0; f < faceCount; f++) {
+		const H_edge* edge = object.faces[f]->edge;
+		do {
+			int v = vertexIndex.value(edge->vert_origin);
+			faceVertices.append(v);
+			adjacencyStart[v + 1]++;
+			edge = edge->edge_next;
+		} while (edge != object.faces[f]->edge);
+		faceStart[f + 1] = faceVertices.length();
+	}
+	for (int v = 0; v < vertexCount; v++) {
+		adjacencyStart[v + 1] += adjacencyStart[v];
+	}
+	QVector<int> adjacency(faceVertices.length());
+	QVector<int> adjacencyFill = adjacencyStart;
+	for (int f = 0; f < faceCount; f++) {
+		for (int i = faceStart[f]; i < faceStart[f + 1]; i++) {
+			adjacency[adjacencyFill[faceVertices[i]]++] = f;
+		}
+	}
+
+	//Tipsify (Sander, Nehab, Barczak 2007) inside every cluster, cluster keeps its faces and cache state continues into next one
+	QVector<int> liveFaces(vertexCount, 0);
+	QVector<int> cacheTime(vertexCount, -cacheSize - 1);
+	QVector<bool> emitted(faceCount, false);
+	QVector<int> faceOrder;
+	faceOrder.reserve(faceCount);
+	QVector<int> deadEnd;
+	QVector<int> candidates;
+	int time = 0;
+	for (const Meshlet& meshlet : object.meshlets) {
+		const int first = meshlet.firstFace;
+		const int last = meshlet.firstFace + meshlet.faceCount;
+		for (int f = first; f < last; f++) {
+			for (int i = faceStart[f]; i < faceStart[f + 1]; i++) {
+				liveFaces[faceVertices[i]]++;
+			}
+		}
+		deadEnd.resize(0);
+		int cursor = first;
+		int fanning = faceVertices[faceStart[first]];
+		while (fanning >= 0) {
+			//all faces of cluster around fanning vertex are emitted
+			candidates.resize(0);
+			for (int a = adjacencyStart[fanning]; a < adjacencyStart[fanning + 1]; a++) {
+				int f = adjacency[a];
+				if (f < first || f >= last || emitted[f]) {
+					continue;
+				}
+				emitted[f] = true;
+				faceOrder.append(f);
+				for (int i = faceStart[f]; i < faceStart[f + 1]; i++) {
+					int v = faceVertices[i];
+					deadEnd.append(v);
+					candidates.append(v);
+					liveFaces[v]--;
+					if (time - cacheTime[v] > cacheSize) {
+						cacheTime[v] = time;
+						time++;
+					}
+				}
+			}
+			//next fanning vertex is the oldest one which stays in cache while its remaining faces are emitted
+			fanning = -1;
+			int bestPriority = -1;
+			for (int v : candidates) {
+				if (liveFaces[v] <= 0) {
+					continue;
+				}
+				int priority = 0;
+				if (time - cacheTime[v] + 2 * liveFaces[v] <= cacheSize) {
+					priority = time - cacheTime[v];
+				}
+				if (priority > bestPriority) {
+					bestPriority = priority;
+					fanning = v;
+				}
+			}
+			//dead end, recently used vertex with faces left, otherwise next face of cluster in old order
+			while (fanning < 0 && !deadEnd.isEmpty()) {
+				int v = deadEnd.takeLast();
+				if (liveFaces[v] > 0) {
+					fanning = v;
+				}
+			}
+			while (fanning < 0 && cursor < last) {
+				if (!emitted[cursor]) {
+					fanning = faceVertices[faceStart[cursor]];
+				}
+				cursor++;
+			}
+		}
+	}
+	//faces of object without clusters keep their order
+	for (int f = 0; f < faceCount; f++) {
+		if (!emitted[f]) {
+			faceOrder.append(f);
+		}
+	}
+	object.applyFaceOrder(faceOrder);
+	object.buildIndices();
+	report.acmrAfter = averageCacheMissRatio(object.triangle_indices, cacheSize);
+	return report;
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <QVector>
+
+class Object_H_edge;
+
+//Post-transform vertex cache is simulated as FIFO of this many vertices
+const int vertexCacheSize = 16;
+
+//Average cache miss ratio, vertices transformed per triangle when triangles are drawn in given order (3 is worst, about 0.6 is good)
+double averageCacheMissRatio(const QVector<int>& triangleIndices, int cacheSize = vertexCacheSize);
+
+struct VertexCacheReport {
+	double acmrBefore = 0;
+	double acmrAfter = 0;
+};
+
+//Reorders faces inside every cluster of object by Tipsify, so faces around one vertex are drawn together while it's in cache,
+//vertices are renumbered by first use and indices rebuilt. savePolygonsVTK writes object in this order
+VertexCacheReport optimizeVertexCache(Object_H_edge& object, int cacheSize = vertexCacheSize);